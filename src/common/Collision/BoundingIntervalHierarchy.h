@@ -119,6 +119,23 @@ public:
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst = false) const
+    {
+        intersectRayLeaves(r, [&](uint32 const* entries, uint32 count, float& distance)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                bool hit = intersectCallback(r, entries[i], distance, stopAtFirst);
+                if (stopAtFirst && hit)
+                    return true;
+            }
+            return false;
+        }, maxDist);
+    }
+
+    /* Same traversal as intersectRay, but leafCallback is called once per leaf with all its objects, for callers testing several objects at once.
+    bool leafCallback(uint32 const* entries, uint32 count, float& maxDist) must return true to stop the traversal. */
+    template<typename LeafCallback>
+    void intersectRayLeaves(const G3D::Ray &r, LeafCallback&& leafCallback, float &maxDist) const
     {
         float intervalMin = -1.f;
         float intervalMax = -1.f;
@@ -171,11 +188,12 @@ public:
         StackNode stack[MAX_STACK_SIZE];
         int stackPos = 0;
         int node = 0;
+        uint32 const* nodes = tree.data();
 
         while (true) {
             while (true)
             {
-                uint32 tn = tree[node];
+                uint32 tn = nodes[node];
                 uint32 axis = (tn & (3 << 30)) >> 30;
                 bool BVH2 = (tn & (1 << 29)) != 0;
                 int offset = tn & ~(7 << 29);
@@ -184,8 +202,8 @@ public:
                     if (axis < 3)
                     {
                         // "normal" interior node
-                        float tf = (intBitsToFloat(tree[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
-                        float tb = (intBitsToFloat(tree[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
+                        float tf = (intBitsToFloat(nodes[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
+                        float tb = (intBitsToFloat(nodes[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
                         // ray passes between clip zones
                         if (tf < intervalMin && tb > intervalMax)
                             break;
@@ -215,13 +233,9 @@ public:
                     else
                     {
                         // leaf - test some objects
-                        int n = tree[node + 1];
-                        while (n > 0) {
-                            bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
-                            if (stopAtFirst && hit) return;
-                            --n;
-                            ++offset;
-                        }
+                        int n = nodes[node + 1];
+                        if (n > 0 && leafCallback(objects.data() + offset, uint32(n), maxDist))
+                            return;
                         break;
                     }
                 }
@@ -229,8 +243,8 @@ public:
                 {
                     if (axis>2)
                         return; // should not happen
-                    float tf = (intBitsToFloat(tree[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
-                    float tb = (intBitsToFloat(tree[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
+                    float tf = (intBitsToFloat(nodes[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
+                    float tb = (intBitsToFloat(nodes[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
                     node = offset;
                     intervalMin = (tf >= intervalMin) ? tf : intervalMin;
                     intervalMax = (tb <= intervalMax) ? tb : intervalMax;
@@ -334,6 +348,87 @@ public:
         }
     }
 
+    /* Calls intersectCallback(entry) for each object which may overlap given box.
+    Node clip planes are conservative, some of the objects may not overlap the box. */
+    template<typename BoxCallback>
+    void intersectBox(const G3D::AABox &box, BoxCallback& intersectCallback) const
+    {
+        if (objects.empty() || !bounds.intersects(box))
+            return;
+
+        G3D::Vector3 const& lo = box.low();
+        G3D::Vector3 const& hi = box.high();
+        uint32 const* nodes = tree.data();
+        uint32 stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        uint32 node = 0;
+
+        while (true) {
+            while (true)
+            {
+                uint32 tn = nodes[node];
+                uint32 axis = (tn & (3 << 30)) >> 30;
+                bool BVH2 = (tn & (1 << 29)) != 0;
+                uint32 offset = tn & ~(7 << 29);
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node
+                        float tl = intBitsToFloat(nodes[node + 1]);
+                        float tr = intBitsToFloat(nodes[node + 2]);
+                        bool left = lo[axis] <= tl;
+                        bool right = hi[axis] >= tr;
+                        if (left && right)
+                        {
+                            // box is in both nodes, push back right node
+                            stack[stackPos++] = offset + 3;
+                            node = offset;
+                            continue;
+                        }
+                        if (left)
+                        {
+                            node = offset;
+                            continue;
+                        }
+                        if (right)
+                        {
+                            node = offset + 3;
+                            continue;
+                        }
+                        break;
+                    }
+                    else
+                    {
+                        // leaf - return its objects
+                        uint32 n = nodes[node + 1];
+                        for (uint32 i = 0; i < n; ++i)
+                            intersectCallback(objects[offset + i]);
+                        break;
+                    }
+                }
+                else // BVH2 node (empty space cut off left and right)
+                {
+                    if (axis > 2)
+                        return; // should not happen
+                    float tl = intBitsToFloat(nodes[node + 1]);
+                    float tr = intBitsToFloat(nodes[node + 2]);
+                    node = offset;
+                    if (tl > hi[axis] || tr < lo[axis])
+                        break;
+                    continue;
+                }
+            } // traversal loop
+
+            // stack is empty?
+            if (stackPos == 0)
+                return;
+            // move back up the stack
+            stackPos--;
+            node = stack[stackPos];
+        }
+    }
+
     bool writeToFile(FILE* wf) const;
     bool readFromFile(FILE* rf);
 
@@ -55,6 +55,15 @@ class BIHWrap
             if (const T* obj = objects[idx])
                 _callback(p, *obj);
         }
+
+        /// Intersect box
+        void operator() (uint32 idx)
+        {
+            if (idx >= objects_size)
+                return;
+            if (const T* obj = objects[idx])
+                _callback(*obj);
+        }
     };
 
     typedef G3D::Array<const T*> ObjArray;
@@ -114,6 +123,14 @@ public:
         MDLCallback<IsectCallback> callback(intersectCallback, m_objects.getCArray(), m_objects.size());
         m_tree.intersectPoint(point, callback);
     }
+
+    template<typename BoxCallback>
+    void intersectBox(const G3D::AABox& box, BoxCallback& intersectCallback)
+    {
+        balance();
+        MDLCallback<BoxCallback> callback(intersectCallback, m_objects.getCArray(), m_objects.size());
+        m_tree.intersectBox(box, callback);
+    }
 };
 
 #endif // _BIH_WRAP
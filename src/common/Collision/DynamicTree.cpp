@@ -27,6 +27,7 @@
 #include "GameObjectModel.h"
 #include "ModelInstance.h"
 #include "ModelIgnoreFlags.h"
+#include "IVMapManager.h"
 
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
@@ -242,6 +243,67 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSightMulti(std::vector<VMAP::LineOfSightSegment> const& segments, uint32 phasemask, std::vector<bool>& results) const
+{
+    G3D::AABox bounds;
+    bool hasBounds = false;
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        if (!results[i])
+            continue;
+
+        G3D::Vector3 v1(segments[i].x1, segments[i].y1, segments[i].z1), v2(segments[i].x2, segments[i].y2, segments[i].z2);
+        G3D::AABox segmentBounds(v1.min(v2), v1.max(v2));
+        if (hasBounds)
+            bounds.merge(segmentBounds);
+        else
+            bounds = segmentBounds;
+        hasBounds = true;
+    }
+
+    if (!hasBounds)
+        return;
+
+    std::vector<GameObjectModel const*> models;
+    auto collectModels = [&](GameObjectModel const& model)
+    {
+        models.push_back(&model);
+    };
+    impl->intersectBox(bounds, collectModels);
+    if (models.empty())
+        return;
+
+    // models spanning several grid cells were found more than once
+    std::sort(models.begin(), models.end());
+    models.erase(std::unique(models.begin(), models.end()), models.end());
+
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        if (!results[i])
+            continue;
+
+        G3D::Vector3 v1(segments[i].x1, segments[i].y1, segments[i].z1), v2(segments[i].x2, segments[i].y2, segments[i].z2);
+        float maxDist = (v2 - v1).magnitude();
+        if (!G3D::fuzzyGt(maxDist, 0))
+            continue;
+
+        G3D::AABox segmentBounds(v1.min(v2), v1.max(v2));
+        G3D::Ray r(v1, (v2 - v1) / maxDist);
+        for (GameObjectModel const* model : models)
+        {
+            if (!model->getBounds().intersects(segmentBounds))
+                continue;
+
+            float distance = maxDist;
+            if (model->intersectRay(r, distance, true, phasemask, VMAP::ModelIgnoreFlags::Nothing))
+            {
+                results[i] = false;
+                break;
+            }
+        }
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     G3D::Vector3 v(x, y, z);
@@ -3,6 +3,7 @@
 #define _DYNTREE_H
 
 #include "Define.h"
+#include <vector>
 
 namespace G3D
 {
@@ -13,6 +14,11 @@ namespace G3D
 class GameObjectModel;
 struct DynTreeImpl;
 
+namespace VMAP
+{
+    struct LineOfSightSegment;
+}
+
 class TC_COMMON_API DynamicMapTree
 {
     DynTreeImpl *impl;
@@ -24,6 +30,11 @@ public:
 
     bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                          float z2, uint32 phasemask) const;
+    /**
+    isInLineOfSight for several segments, results must hold one entry per segment and only true entries are tested.
+    Models are collected once for the bounds of all segments.
+    */
+    void isInLineOfSightMulti(std::vector<VMAP::LineOfSightSegment> const& segments, uint32 phasemask, std::vector<bool>& results) const;
 
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
                              const G3D::Vector3& endPos, float& maxDist) const;
@@ -24,6 +24,7 @@
 #include "WaterDefines.h"
 #include "ModelIgnoreFlags.h"
 #include "Common.h"
+#include <vector>
 
 //===========================================================
 
@@ -74,6 +75,13 @@ namespace VMAP
         Optional<AreaInfo> areaInfo;
         Optional<LiquidInfo> liquidInfo;
     };
+    // One line of sight test of a batch, in game coordinates
+    struct LineOfSightSegment
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+    };
+
     //===========================================================
     class TC_COMMON_API IVMapManager
     {
@@ -94,6 +102,16 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+            /**
+            isInLineOfSight for several segments at once, results must hold one entry per segment.
+            Segments with a false result are skipped, the others get false if line of sight is blocked.
+            */
+            virtual void isInLineOfSightMulti(unsigned int pMapId, std::vector<LineOfSightSegment> const& segments, ModelIgnoreFlags ignoreFlags, std::vector<bool>& results)
+            {
+                for (size_t i = 0; i < segments.size(); ++i)
+                    if (results[i])
+                        results[i] = isInLineOfSight(pMapId, segments[i].x1, segments[i].y1, segments[i].z1, segments[i].x2, segments[i].y2, segments[i].z2, ignoreFlags);
+            }
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             virtual float getCeil(unsigned int /*pMapId*/, float /*x*/, float /*y*/, float /*z*/, float /*maxSearchDist*/) { return VMAP_INVALID_CEIL_VALUE; }
 
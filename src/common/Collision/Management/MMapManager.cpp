@@ -115,6 +115,8 @@ namespace MMAP
 
     bool MMapManager::loadMap(const std::string& /* basePath */, uint32 mapId, int32 x, int32 y)
     {
+        std::lock_guard<std::mutex> lock(loadedTilesLock);
+
         // make sure the mmap is loaded and ready to load tiles
         if (!loadMapData(mapId))
             return false;
@@ -190,6 +192,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        std::lock_guard<std::mutex> lock(loadedTilesLock);
+
         // check if we have this map loaded
         auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
@@ -234,6 +238,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        std::lock_guard<std::mutex> lock(loadedTilesLock);
+
         auto itr = loadedMMaps.find(mapId);
         if (itr == loadedMMaps.end() || !itr->second)
         {
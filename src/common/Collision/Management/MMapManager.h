@@ -23,6 +23,8 @@
 #include "DetourAlloc.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -82,7 +84,9 @@ namespace MMAP
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
-            uint32 loadedTiles;
+            std::atomic<uint32> loadedTiles;
+            // map update threads may load or unload grids of several maps at once
+            std::mutex loadedTilesLock;
             bool thread_safe_environment;
     };
 }
@@ -87,6 +87,7 @@ namespace VMAP
         int result = VMAP_LOAD_RESULT_IGNORED;
         if (isMapLoadingEnabled())
         {
+            std::lock_guard<std::mutex> lock(LoadedMapTilesLock);
             if (_loadMap(mapId, basePath, x, y))
                 result = VMAP_LOAD_RESULT_OK;
             else
@@ -136,6 +137,7 @@ namespace VMAP
 
     void VMapManager2::unloadMap(unsigned int mapId)
     {
+        std::lock_guard<std::mutex> lock(LoadedMapTilesLock);
         auto instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree != iInstanceMapTrees.end() && instanceTree->second)
         {
@@ -150,6 +152,7 @@ namespace VMAP
 
     void VMapManager2::unloadMap(unsigned int mapId, int x, int y)
     {
+        std::lock_guard<std::mutex> lock(LoadedMapTilesLock);
         auto instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree != iInstanceMapTrees.end() && instanceTree->second)
         {
@@ -181,6 +184,23 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSightMulti(unsigned int mapId, std::vector<LineOfSightSegment> const& segments, ModelIgnoreFlags ignoreFlags, std::vector<bool>& results)
+    {
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<std::pair<Vector3, Vector3>> internalSegments;
+        internalSegments.reserve(segments.size());
+        for (LineOfSightSegment const& segment : segments)
+            internalSegments.emplace_back(convertPositionToInternalRep(segment.x1, segment.y1, segment.z1), convertPositionToInternalRep(segment.x2, segment.y2, segment.z2));
+
+        instanceTree->second->isInLineOfSightMulti(internalSegments, ignoreFlags, results);
+    }
+
     /* same as getObjectHitPos but a bit more gentle, will try from a bit higher and return collision from there if it gets further */
     bool VMapManager2::getLeapHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist)
     {
@@ -83,6 +83,8 @@ namespace VMAP
             bool thread_safe_environment;
             // Mutex for iLoadedModelFiles
             std::mutex LoadedModelFilesLock;
+            // Mutex for tiles loading and unloading, map update threads may load or unload grids of several maps at once
+            std::mutex LoadedMapTilesLock;
 
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
             /* void _unloadMap(uint32 pMapId, uint32 x, uint32 y); */
@@ -106,6 +108,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override;
+            void isInLineOfSightMulti(unsigned int mapId, std::vector<LineOfSightSegment> const& segments, ModelIgnoreFlags ignoreFlags, std::vector<bool>& results) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -207,6 +207,69 @@ namespace VMAP
     }
     //=========================================================
 
+    void StaticMapTree::isInLineOfSightMulti(std::vector<std::pair<Vector3, Vector3>> const& segments, ModelIgnoreFlags ignoreFlags, std::vector<bool>& results) const
+    {
+        G3D::AABox bounds;
+        bool hasBounds = false;
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            if (!results[i])
+                continue;
+
+            G3D::AABox segmentBounds(segments[i].first.min(segments[i].second), segments[i].first.max(segments[i].second));
+            if (hasBounds)
+                bounds.merge(segmentBounds);
+            else
+                bounds = segmentBounds;
+            hasBounds = true;
+        }
+
+        if (!hasBounds)
+            return;
+
+        std::vector<ModelInstance const*> models;
+        auto collectModels = [&](uint32 entry)
+        {
+            if (iTreeValues[entry].getWorldModel())
+                models.push_back(&iTreeValues[entry]);
+        };
+        iTree.intersectBox(bounds, collectModels);
+
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            if (!results[i] || segments[i].first == segments[i].second)
+                continue;
+
+            Vector3 const& pos1 = segments[i].first;
+            Vector3 const& pos2 = segments[i].second;
+            float maxDist = (pos2 - pos1).magnitude();
+            // same checks as isInLineOfSight
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+            if (maxDist < 1e-10f)
+                continue;
+
+            G3D::AABox segmentBounds(pos1.min(pos2), pos1.max(pos2));
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(pos1, (pos2 - pos1) / maxDist);
+            for (ModelInstance const* model : models)
+            {
+                if (!model->getBounds().intersects(segmentBounds))
+                    continue;
+
+                float distance = maxDist;
+                if (model->intersectRay(ray, distance, true, ignoreFlags))
+                {
+                    results[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+    //=========================================================
+
     bool StaticMapTree::getObjectHitPos(const Vector3& pPos1, const Vector3& pPos2, Vector3& pResultHitPos, float pModifyDist) const
     {
         bool result=false;
@@ -60,6 +60,11 @@ namespace VMAP
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
             /**
+            isInLineOfSight for several segments, results must hold one entry per segment and only true entries are tested.
+            The tree is walked once for the bounds of all segments, each segment is then tested against the models found.
+            */
+            void isInLineOfSightMulti(std::vector<std::pair<G3D::Vector3, G3D::Vector3>> const& segments, ModelIgnoreFlags ignoreFlags, std::vector<bool>& results) const;
+            /**
             When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
             Return the hit pos or the original dest pos
             */
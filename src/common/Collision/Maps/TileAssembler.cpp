@@ -21,9 +21,13 @@
 #include "BoundingIntervalHierarchy.h"
 #include "VMapDefinitions.h"
 
+#include <atomic>
+#include <fstream>
 #include <set>
 #include <sstream>
 #include <iomanip>
+#include <thread>
+#include <boost/filesystem.hpp>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -53,7 +57,7 @@ namespace VMAP
     //=================================================================
 
     TileAssembler::TileAssembler(std::string  pSrcDirName, std::string  pDestDirName)
-        : iDestDir(std::move(pDestDirName)), iSrcDir(std::move(pSrcDirName)), iFilterMethod(nullptr), iCurrentUniqueNameId(0)
+        : iDestDir(std::move(pDestDirName)), iSrcDir(std::move(pSrcDirName)), iFilterMethod(nullptr), iCurrentUniqueNameId(0), iThreads(1)
     {
         //mkdir(iDestDir);
         //init();
@@ -64,6 +68,29 @@ namespace VMAP
         //delete iCoordModelMapping;
     }
 
+    // Run task(i) for each i in [0, count) on up to 'threads' threads. Stops scheduling tasks after a failure
+    template<class Task>
+    static bool RunParallel(uint32 threads, size_t count, Task const& task)
+    {
+        std::atomic<size_t> next(0);
+        std::atomic<bool> success(true);
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count && success; i = next++)
+                if (!task(i))
+                    success = false;
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < std::min<size_t>(threads, count); ++i)
+            workers.emplace_back(worker);
+        worker();
+        for (std::thread& thread : workers)
+            thread.join();
+
+        return success;
+    }
+
     bool TileAssembler::convertWorld2()
     {
         bool success = readMapSpawns();
@@ -71,139 +98,249 @@ namespace VMAP
             return false;
 
         // export Map data
-        for (auto map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        std::vector<std::pair<uint32, MapSpawns*>> maps(mapData.begin(), mapData.end());
+        success = RunParallel(iThreads, maps.size(), [&](size_t i)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    /// @todo remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
-            }
+            return convertMap(maps[i].first, *maps[i].second);
+        });
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects
+        if (success)
+            success = convertModels();
 
-            try
+        //cleanup:
+        for (auto & map_iter : mapData)
+        {
+            delete map_iter.second;
+        }
+        return success;
+    }
+
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns& spawns)
+    {
+        bool success = true;
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        ModelVertexCache vertexCache; // only kept while this map is converted
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+                if (!calculateTransformedBound(entry->second, vertexCache))
+                    break;
             }
-            catch (std::exception& e)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
-                return false;
+                /// @todo remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+        }
+
+        {
+            // models used by several maps are only converted once
+            std::lock_guard<std::mutex> lock(iLock);
+            for (ModelSpawn const* spawn : mapSpawns)
+                spawnedModelFiles.insert(spawn->name);
+        }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
-            {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
-            }
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
+        }
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (auto glob=globalRange.first; glob != globalRange.second && success; ++glob)
-            {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
-            }
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
 
-            fclose(mapfile);
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
 
-            // <====
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (auto glob=globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn &spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << '/' << std::setw(3) << mapId << '_';
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+            if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
             {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << '/' << std::setw(3) << map_iter->first << '_';
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-                if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+                // write tile spawns
+                for (uint32 s=0; s<nSpawns; ++s)
                 {
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    // write tile spawns
-                    for (uint32 s=0; s<nSpawns; ++s)
-                    {
-                        if (s)
-                            ++tile;
-                        const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                        success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                        // MapTree nodes to update when loading tile:
-                        auto nIdx = modelNodeIdx.find(spawn2.ID);
-                        if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    }
-                    fclose(tilefile);
+                    if (s)
+                        ++tile;
+                    const ModelSpawn &spawn2 = spawns.UniqueEntries[tile->second];
+                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                    // MapTree nodes to update when loading tile:
+                    auto nIdx = modelNodeIdx.find(spawn2.ID);
+                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
                 }
+                fclose(tilefile);
             }
-            // break; //test, extract only first map; TODO: remvoe this line
         }
+        return success;
+    }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
+    bool TileAssembler::convertModels()
+    {
         std::cout << "\nConverting Model Files" << std::endl;
-        for (const auto & spawnedModelFile : spawnedModelFiles)
+        std::map<std::string, RawFileStamp> const previousManifest = readManifest();
+        std::vector<std::string> const files(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::vector<RawFileStamp> stamps(files.size());
+        std::atomic<uint32> skipped(0);
+
+        bool success = RunParallel(iThreads, files.size(), [&](size_t i)
         {
-            std::cout << "Converting " << spawnedModelFile << std::endl;
-            if (!convertRawFile(spawnedModelFile))
+            std::string const& file = files[i];
+            stamps[i] = getRawFileStamp(file);
+            auto itr = previousManifest.find(file);
+            if (itr != previousManifest.end() && stamps[i].size && itr->second == stamps[i]
+                && boost::filesystem::exists(iDestDir + "/" + file + ".vmo"))
             {
-                std::cout << "error converting " << spawnedModelFile << std::endl;
-                success = false;
-                break;
+                ++skipped;
+                return true;
             }
+
+            printf("Converting %s\n", file.c_str());
+            if (!convertRawFile(file))
+            {
+                printf("error converting %s\n", file.c_str());
+                return false;
+            }
+            return true;
+        });
+
+        std::cout << skipped << " unchanged models skipped" << std::endl;
+        if (!success)
+            return false;
+
+        std::map<std::string, RawFileStamp> manifest;
+        for (size_t i = 0; i < files.size(); ++i)
+            manifest[files[i]] = stamps[i];
+        return writeManifest(manifest);
+    }
+
+    RawFileStamp TileAssembler::getRawFileStamp(std::string const& name) const
+    {
+        namespace fs = boost::filesystem;
+
+        // same fallback as WorldModel_Raw::Read
+        fs::path path(iSrcDir + "/" + name);
+        boost::system::error_code error;
+        if (!fs::exists(path, error) && name.size() >= 3)
+            path = iSrcDir + "/" + name.substr(0, name.size() - 3) + "m2";
+
+        RawFileStamp stamp;
+        uint64 size = fs::file_size(path, error);
+        if (error)
+            return stamp;
+        std::time_t time = fs::last_write_time(path, error);
+        if (error)
+            return stamp;
+
+        stamp.size = size;
+        stamp.time = int64(time);
+        return stamp;
+    }
+
+    std::string TileAssembler::getManifestHeader()
+    {
+        std::ostringstream header;
+        header << VMAP_MAGIC << ' ' << RAW_VMAP_MAGIC << ' ' << ASSEMBLER_MANIFEST_VERSION;
+        return header.str();
+    }
+
+    std::map<std::string, RawFileStamp> TileAssembler::readManifest() const
+    {
+        std::map<std::string, RawFileStamp> manifest;
+        std::ifstream file(iDestDir + "/" + ASSEMBLER_MANIFEST);
+        std::string line;
+        // models converted with another format are all converted again
+        if (!std::getline(file, line) || line != getManifestHeader())
+            return manifest;
+
+        while (std::getline(file, line))
+        {
+            // <size> <time> <name>, names may contain spaces
+            std::istringstream stream(line);
+            RawFileStamp stamp;
+            std::string name;
+            if (!(stream >> stamp.size >> stamp.time) || !std::getline(stream >> std::ws, name) || name.empty())
+                continue;
+            manifest[name] = stamp;
         }
+        return manifest;
+    }
 
-        //cleanup:
-        for (auto & map_iter : mapData)
+    bool TileAssembler::writeManifest(std::map<std::string, RawFileStamp> const& manifest) const
+    {
+        std::ofstream file(iDestDir + "/" + ASSEMBLER_MANIFEST, std::ios::trunc);
+        if (!file)
         {
-            delete map_iter.second;
+            printf("Cannot write %s/%s\n", iDestDir.c_str(), ASSEMBLER_MANIFEST);
+            return false;
         }
-        return success;
+
+        file << getManifestHeader() << '\n';
+        for (auto const& entry : manifest)
+            file << entry.second.size << ' ' << entry.second.time << ' ' << entry.first << '\n';
+        return bool(file);
     }
 
     bool TileAssembler::readMapSpawns()
@@ -247,48 +384,59 @@ namespace VMAP
         return success;
     }
 
-    bool TileAssembler::calculateTransformedBound(ModelSpawn &spawn)
+    std::vector<Vector3> const* TileAssembler::getModelVertices(std::string const& name, ModelVertexCache& cache)
     {
+        auto itr = cache.find(name);
+        if (itr != cache.end())
+            return &itr->second;
+
         std::string modelFilename(iSrcDir);
         modelFilename.push_back('/');
-        modelFilename.append(spawn.name);
-
-        ModelPosition modelPosition;
-        modelPosition.iDir = spawn.iRot;
-        modelPosition.iScale = spawn.iScale;
-        modelPosition.init();
+        modelFilename.append(name);
 
         WorldModel_Raw raw_model;
         if (!raw_model.Read(modelFilename.c_str()))
-            return false;
+            return nullptr;
 
         uint32 groups = raw_model.groupsArray.size();
         if (groups != 1)
             printf("Warning: '%s' does not seem to be a M2 model!\n", modelFilename.c_str());
 
-        AABox modelBound;
-        bool boundEmpty=true;
-
+        std::vector<Vector3>& vertices = cache[name];
         for (uint32 g=0; g<groups; ++g) // should be only one for M2 files...
         {
-            std::vector<Vector3>& vertices = raw_model.groupsArray[g].vertexArray;
+            std::vector<Vector3> const& groupVertices = raw_model.groupsArray[g].vertexArray;
+            if (groupVertices.empty())
+                printf("error: model '%s' has no geometry!\n", name.c_str());
 
-            if (vertices.empty())
-            {
-                std::cout << "error: model '" << spawn.name << "' has no geometry!" << std::endl;
-                continue;
-            }
+            vertices.insert(vertices.end(), groupVertices.begin(), groupVertices.end());
+        }
 
-            uint32 nvectors = vertices.size();
-            for (uint32 i = 0; i < nvectors; ++i)
-            {
-                Vector3 v = modelPosition.transform(vertices[i]);
+        return &vertices;
+    }
 
-                if (boundEmpty)
-                    modelBound = AABox(v, v), boundEmpty=false;
-                else
-                    modelBound.merge(v);
-            }
+    bool TileAssembler::calculateTransformedBound(ModelSpawn &spawn, ModelVertexCache& cache)
+    {
+        ModelPosition modelPosition;
+        modelPosition.iDir = spawn.iRot;
+        modelPosition.iScale = spawn.iScale;
+        modelPosition.init();
+
+        std::vector<Vector3> const* vertices = getModelVertices(spawn.name, cache);
+        if (!vertices)
+            return false;
+
+        AABox modelBound;
+        bool boundEmpty=true;
+
+        for (Vector3 const& vertex : *vertices)
+        {
+            Vector3 v = modelPosition.transform(vertex);
+
+            if (boundEmpty)
+                modelBound = AABox(v, v), boundEmpty=false;
+            else
+                modelBound.merge(v);
         }
         spawn.iBound = modelBound + spawn.iPos;
         spawn.flags |= MOD_HAS_BOUND;
@@ -25,7 +25,9 @@
 #include <G3D/Vector3.h>
 #include <G3D/Matrix3.h>
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
 namespace VMAP
 {
@@ -90,6 +92,23 @@ namespace VMAP
         bool Read(const char * path);
     };
 
+    // Size and modification time of a raw model file, models with unchanged stamps are not converted again
+    struct RawFileStamp
+    {
+        uint64 size = 0;
+        int64 time = 0;
+
+        bool operator==(RawFileStamp const& right) const { return size == right.size && time == right.time; }
+    };
+
+    // vertices of M2 models, read once for all their spawns in a map
+    typedef std::unordered_map<std::string, std::vector<G3D::Vector3>> ModelVertexCache;
+
+    /**
+    Maps are converted in parallel, then models used by all maps are converted once each, in parallel.
+    A manifest of converted models is kept in the destination directory so that a new run only converts changed models.
+    The manifest also holds vmap magics and version, all models are converted again when they change.
+    */
     class TC_COMMON_API TileAssembler
     {
         private:
@@ -98,16 +117,28 @@ namespace VMAP
             bool (*iFilterMethod)(char *pName);
             G3D::Table<std::string, unsigned int > iUniqueNameIds;
             unsigned int iCurrentUniqueNameId;
+            uint32 iThreads;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            std::mutex iLock; // protects spawnedModelFiles while maps are converted
+
+            bool convertMap(uint32 mapId, MapSpawns& spawns);
+            bool convertModels();
+            std::vector<G3D::Vector3> const* getModelVertices(std::string const& name, ModelVertexCache& cache);
+            RawFileStamp getRawFileStamp(std::string const& name) const;
+            static std::string getManifestHeader();
+            std::map<std::string, RawFileStamp> readManifest() const;
+            bool writeManifest(std::map<std::string, RawFileStamp> const& manifest) const;
 
         public:
             TileAssembler(std::string  pSrcDirName, std::string  pDestDirName);
             virtual ~TileAssembler();
 
+            void setThreadCount(uint32 threads) { iThreads = std::max(threads, 1u); }
+
             bool convertWorld2();
             bool readMapSpawns();
-            bool calculateTransformedBound(ModelSpawn &spawn);
+            bool calculateTransformedBound(ModelSpawn &spawn, ModelVertexCache& cache);
             void exportGameobjectModels();
 
             bool convertRawFile(const std::string& pModelFilename);
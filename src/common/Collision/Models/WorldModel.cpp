@@ -348,17 +348,97 @@ namespace VMAP
         return result;
     }
 
-    struct GModelRayCallback
+    /* Tests the triangles of a mesh tree leaf 4 at a time (leaves hold up to 3 triangles).
+    Same math as IntersectTriangle, but on fixed size arrays without early exits so that compilers turn the lanes into SIMD,
+    and with the per ray values computed once. Hits are then applied in leaf order, giving the exact same results as the one by one test. */
+    struct GModelRayLeafCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) { }
-        bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
+        static uint32 const LANES = 4;
+
+        GModelRayLeafCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert, const G3D::Ray& ray, bool stopAtFirstHit) :
+            vertices(vert.data()), triangles(tris.data()), stopAtFirst(stopAtFirstHit), hit(false)
         {
-            hit = IntersectTriangle(triangles[entry], vertices, ray, distance) || hit;
-            return hit;
+            for (uint32 i = 0; i < 3; ++i)
+            {
+                org[i] = ray.origin()[i];
+                dir[i] = ray.direction()[i];
+            }
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+
+        bool operator()(uint32 const* entries, uint32 count, float& distance)
+        {
+            for (uint32 first = 0; first < count; first += LANES)
+            {
+                uint32 lanes = std::min(count - first, LANES);
+                float t[LANES];
+                bool valid[LANES];
+                IntersectLanes(entries + first, lanes, t, valid);
+
+                for (uint32 i = 0; i < lanes; ++i)
+                {
+                    if (!valid[i] || t[i] >= distance)
+                        continue;
+
+                    // This is a new hit, closer than the previous one
+                    distance = t[i];
+                    hit = true;
+                    if (stopAtFirst)
+                        return true;
+                }
+            }
+            return false;
+        }
+
+        void IntersectLanes(uint32 const* entries, uint32 lanes, float* t, bool* valid) const
+        {
+            static const float EPS = 1e-5f;
+
+            float p0[3][LANES], e1[3][LANES], e2[3][LANES];
+            for (uint32 i = 0; i < LANES; ++i)
+            {
+                // unused lanes repeat the first triangle, their result is ignored
+                MeshTriangle const& tri = triangles[entries[i < lanes ? i : 0]];
+                Vector3 const& v0 = vertices[tri.idx0];
+                Vector3 const& v1 = vertices[tri.idx1];
+                Vector3 const& v2 = vertices[tri.idx2];
+                for (uint32 c = 0; c < 3; ++c)
+                {
+                    p0[c][i] = v0[c];
+                    e1[c][i] = v1[c] - v0[c];
+                    e2[c][i] = v2[c] - v0[c];
+                }
+            }
+
+            for (uint32 i = 0; i < LANES; ++i)
+            {
+                // p = dir x e2
+                float const px = dir[1] * e2[2][i] - dir[2] * e2[1][i];
+                float const py = dir[2] * e2[0][i] - dir[0] * e2[2][i];
+                float const pz = dir[0] * e2[1][i] - dir[1] * e2[0][i];
+                float const a = e1[0][i] * px + e1[1][i] * py + e1[2][i] * pz;
+
+                float const f = 1.0f / a;
+                float const sx = org[0] - p0[0][i];
+                float const sy = org[1] - p0[1][i];
+                float const sz = org[2] - p0[2][i];
+                float const u = f * (sx * px + sy * py + sz * pz);
+
+                // q = s x e1
+                float const qx = sy * e1[2][i] - sz * e1[1][i];
+                float const qy = sz * e1[0][i] - sx * e1[2][i];
+                float const qz = sx * e1[1][i] - sy * e1[0][i];
+                float const v = f * (dir[0] * qx + dir[1] * qy + dir[2] * qz);
+
+                t[i] = f * (e2[0][i] * qx + e2[1][i] * qy + e2[2][i] * qz);
+                valid[i] = (std::fabs(a) >= EPS) & (u >= 0.0f) & (u <= 1.0f) & (v >= 0.0f) & ((u + v) <= 1.0f) & (t[i] > 0.0f);
+            }
+        }
+
+        Vector3 const* vertices;
+        MeshTriangle const* triangles;
+        float org[3];
+        float dir[3];
+        bool stopAtFirst;
         bool hit;
     };
 
@@ -367,8 +447,8 @@ namespace VMAP
         if (triangles.empty())
             return false;
 
-        GModelRayCallback callback(triangles, vertices);
-        meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
+        GModelRayLeafCallback callback(triangles, vertices, ray, stopAtFirstHit);
+        meshTree.intersectRayLeaves(ray, callback, distance);
         return callback.hit;
     }
 
@@ -27,6 +27,8 @@ namespace VMAP
     const char VMAP_MAGIC[] = "VMAP_4.3s"; //s for sunstrider
     const char RAW_VMAP_MAGIC[] = "VMAP043s";                // used in extracted vmap files with raw data
     const char GAMEOBJECT_MODELS[] = "GameObjectModels.dtree";
+    const char ASSEMBLER_MANIFEST[] = "assembler_manifest.txt";
+    const uint32 ASSEMBLER_MANIFEST_VERSION = 1;             // increase when converted model files change without a VMAP_MAGIC change
 
     // defined in TileAssembler.cpp currently...
     bool readChunk(FILE* rf, char *dest, const char *compare, uint32 len);
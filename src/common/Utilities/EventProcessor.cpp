@@ -20,6 +20,7 @@ void BasicEvent::SetAborted()
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_sequence = 0;
     m_aborting = false;
 }
 
@@ -34,12 +35,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front().ExecTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        std::pop_heap(m_events.begin(), m_events.end());
+        BasicEvent* event = m_events.back().Event;
+        m_events.pop_back();
 
         if (event->IsRunning())
         {
@@ -75,35 +76,32 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
+    // work on our own copy, events may be added from Abort or destructors
+    EventList events;
+    events.swap(m_events);
+
     // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    for (EventQueueEntry const& entry : events)
     {
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!entry.Event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            entry.Event->SetAborted();
+            entry.Event->Abort(m_time);
         }
+    }
 
+    for (EventQueueEntry const& entry : events)
+    {
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
-        {
-            ++itr;
-            continue;
-        }
-
-        delete itr->second;
-
-        if (force)
-            ++itr; // Clear the whole container when forcing
+        if (!force && !entry.Event->IsDeletable())
+            m_events.push_back(entry);
         else
-            itr = m_events.erase(itr);
+            delete entry.Event;
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    std::make_heap(m_events.begin(), m_events.end());
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -111,19 +109,22 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     if (set_addtime)
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    m_events.push_back({ e_time, m_sequence++, Event });
+    std::push_heap(m_events.begin(), m_events.end());
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
+    for (EventQueueEntry& entry : m_events)
     {
-        if (itr->second != Event)
+        if (entry.Event != Event)
             continue;
 
+        // same as removing and adding the event again
         Event->m_execTime = newTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime, Event));
+        entry.ExecTime = newTime;
+        entry.Sequence = m_sequence++;
+        std::make_heap(m_events.begin(), m_events.end());
         break;
     }
 }
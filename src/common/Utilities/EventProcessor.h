@@ -21,7 +21,8 @@
 
 #include "Define.h"
 
-#include <map>
+#include <algorithm>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
@@ -66,7 +67,24 @@ private:
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// Events are kept in a binary heap stored in a vector, ordered by execution time then by insertion order.
+// Compared to a multimap this does no allocation per event once the vector has grown, and keeps small queues in one cache line or two.
+struct EventQueueEntry
+{
+    uint64 ExecTime;
+    uint64 Sequence;                                        // insertion order, events planned at the same time execute in the order they were added
+    BasicEvent* Event;
+
+    // std heap functions keep the greatest element on top, we want the soonest one
+    bool operator<(EventQueueEntry const& right) const
+    {
+        if (ExecTime != right.ExecTime)
+            return ExecTime > right.ExecTime;
+        return Sequence > right.Sequence;
+    }
+};
+
+typedef std::vector<EventQueueEntry> EventList;
 
 class TC_COMMON_API EventProcessor
 {
@@ -82,8 +100,19 @@ class TC_COMMON_API EventProcessor
         void ModifyEventTime(BasicEvent* Event, uint64 newTime);
         uint64 CalculateTime(uint64 t_offset) const;
         uint64 CalculateQueueTime(uint64 delay) const;
+        bool Empty() const { return m_events.empty(); }
+        size_t Size() const { return m_events.size(); }
     protected:
+        // Remove (without deleting them) all events matching predicate
+        template<class Predicate>
+        void RemoveEventsIf(Predicate predicate)
+        {
+            m_events.erase(std::remove_if(m_events.begin(), m_events.end(), [&](EventQueueEntry const& entry) { return predicate(entry.Event); }), m_events.end());
+            std::make_heap(m_events.begin(), m_events.end());
+        }
+
         uint64 m_time;
+        uint64 m_sequence;
         EventList m_events;
         bool m_aborting;
 };
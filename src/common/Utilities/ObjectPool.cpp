@@ -0,0 +1,19 @@
+#include "ObjectPool.h"
+
+ObjectPoolRegistry* ObjectPoolRegistry::instance()
+{
+    static ObjectPoolRegistry instance;
+    return &instance;
+}
+
+void ObjectPoolRegistry::Register(ObjectPoolStats const* stats)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _pools.push_back(stats);
+}
+
+std::vector<ObjectPoolStats const*> ObjectPoolRegistry::GetPools() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _pools;
+}
@@ -0,0 +1,297 @@
+#ifndef TRINITY_OBJECTPOOL_H
+#define TRINITY_OBJECTPOOL_H
+
+#include "Define.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Allocation counters of one pool, readable from any thread
+struct ObjectPoolStats
+{
+    typedef void (*SumThreadCountersFn)(uint64& allocations, uint64& deallocations);
+
+    explicit ObjectPoolStats(char const* name, size_t slotSize, uint32 slotsPerSlab, SumThreadCountersFn sumThreadCounters) : Name(name), SlotSize(slotSize), SlotsPerSlab(slotsPerSlab),
+        SumThreadCounters(sumThreadCounters), OversizedAllocations(0), Slabs(0), SharedRefills(0) { }
+
+    char const* Name;
+    size_t SlotSize;
+    uint32 SlotsPerSlab;
+    SumThreadCountersFn SumThreadCounters;     // allocations and deallocations are counted per thread, this sums them
+    std::atomic<uint64> OversizedAllocations;  // objects bigger than a slot, forwarded to the global allocator
+    std::atomic<uint64> Slabs;
+    std::atomic<uint64> SharedRefills;         // thread caches refilled with slots freed by other threads
+};
+
+class TC_COMMON_API ObjectPoolRegistry
+{
+public:
+    static ObjectPoolRegistry* instance();
+
+    void Register(ObjectPoolStats const* stats);
+    std::vector<ObjectPoolStats const*> GetPools() const;
+
+private:
+    mutable std::mutex _lock;
+    std::vector<ObjectPoolStats const*> _pools;
+};
+
+#define sObjectPoolRegistry ObjectPoolRegistry::instance()
+
+/*
+Slab allocator for short lived objects created and deleted at high rate (spells, auras...).
+Used from class specific operator new/delete, so that objects are still created with new and deleted with delete.
+
+Each thread takes slots from its own cache without locking, map threads thus never contend with each other.
+Allocation counters also live in the thread cache, written only by their thread and summed when stats are read.
+Slots are carved from slabs of SlotsPerSlab objects which are never released, memory usage follows the peak object count.
+Objects may be freed from another thread than the one that created them: freed slots go to the freeing thread cache,
+and when a cache grows too big a batch of slots is handed to a shared list, used by threads running out of slots before allocating a new slab.
+When a thread ends, its cached slots and counters are handed to the shared pool. Objects still created or deleted on that thread
+afterwards (during thread local destruction) go directly through the shared pool, under its lock.
+
+SlotSize must be big enough for all types allocated through the pool, bigger objects are forwarded to the global allocator.
+*/
+template<class T, size_t SlotSize = sizeof(T), uint32 SlotsPerSlab = 64>
+class ObjectPool
+{
+    union Slot
+    {
+        Slot* Next;
+        alignas(alignof(std::max_align_t)) char Data[SlotSize];
+    };
+
+    struct Batch
+    {
+        Slot* Head;
+        uint32 Count;
+    };
+
+    // one per thread, on its own cache line
+    struct alignas(64) ThreadCache
+    {
+        Slot* FreeSlots = nullptr;
+        uint32 FreeSlotCount = 0;
+        std::atomic<uint64> Allocations{ 0 };
+        std::atomic<uint64> Deallocations{ 0 };
+    };
+
+    struct Shared
+    {
+        explicit Shared(char const* name) : Stats(name, sizeof(Slot), SlotsPerSlab, &SumThreadCounters), RetiredAllocations(0), RetiredDeallocations(0)
+        {
+            sObjectPoolRegistry->Register(&Stats);
+        }
+
+        std::mutex Lock;
+        std::vector<Batch> Batches;
+        std::vector<ThreadCache*> Caches;
+        uint64 RetiredAllocations;   // counters of ended threads
+        uint64 RetiredDeallocations;
+        ObjectPoolStats Stats;
+    };
+
+    // hands the thread cache back to the shared pool when the thread ends
+    struct ThreadCacheGuard
+    {
+        bool Active = false;
+
+        ~ThreadCacheGuard()
+        {
+            if (_cache)
+                ReleaseThreadCache();
+            _threadEnded = true;
+        }
+    };
+
+public:
+    static void* Allocate(size_t size, char const* name)
+    {
+        Shared& shared = GetShared(name);
+        if (size > SlotSize)
+        {
+            shared.Stats.OversizedAllocations.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        ThreadCache* cache = GetThreadCache(shared);
+        if (!cache)
+            return AllocateShared(shared);
+
+        Increment(cache->Allocations);
+        if (!cache->FreeSlots)
+            Refill(shared, *cache);
+
+        Slot* slot = cache->FreeSlots;
+        cache->FreeSlots = slot->Next;
+        --cache->FreeSlotCount;
+        return slot;
+    }
+
+    static void Deallocate(void* ptr, size_t size, char const* name)
+    {
+        if (!ptr)
+            return;
+
+        if (size > SlotSize)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        Shared& shared = GetShared(name);
+        Slot* slot = static_cast<Slot*>(ptr);
+        ThreadCache* cache = GetThreadCache(shared);
+        if (!cache)
+        {
+            DeallocateShared(shared, slot);
+            return;
+        }
+
+        Increment(cache->Deallocations);
+        slot->Next = cache->FreeSlots;
+        cache->FreeSlots = slot;
+        if (++cache->FreeSlotCount < SlotsPerSlab * 2)
+            return;
+
+        // give half of our slots to other threads
+        Batch batch = { nullptr, 0 };
+        for (; batch.Count < SlotsPerSlab; ++batch.Count)
+        {
+            Slot* next = cache->FreeSlots->Next;
+            cache->FreeSlots->Next = batch.Head;
+            batch.Head = cache->FreeSlots;
+            cache->FreeSlots = next;
+        }
+        cache->FreeSlotCount -= batch.Count;
+
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        shared.Batches.push_back(batch);
+    }
+
+private:
+    // only written by the owning thread, no atomic read-modify-write needed
+    static void Increment(std::atomic<uint64>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // never destroyed, objects may still be deleted during static destruction
+    static Shared& GetShared(char const* name)
+    {
+        static Shared* shared = new Shared(name);
+        return *shared;
+    }
+
+    // nullptr once the thread cache was released at thread end
+    static ThreadCache* GetThreadCache(Shared& shared)
+    {
+        if (_cache)
+            return _cache;
+        if (_threadEnded)
+            return nullptr;
+
+        _cache = new ThreadCache();
+        {
+            std::lock_guard<std::mutex> lock(shared.Lock);
+            shared.Caches.push_back(_cache);
+        }
+        _cacheGuard.Active = true; // constructs the guard of this thread
+        return _cache;
+    }
+
+    static void ReleaseThreadCache()
+    {
+        Shared& shared = GetShared(nullptr);
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        if (_cache->FreeSlots)
+            shared.Batches.push_back({ _cache->FreeSlots, _cache->FreeSlotCount });
+        shared.RetiredAllocations += _cache->Allocations.load(std::memory_order_relaxed);
+        shared.RetiredDeallocations += _cache->Deallocations.load(std::memory_order_relaxed);
+        shared.Caches.erase(std::find(shared.Caches.begin(), shared.Caches.end(), _cache));
+        delete _cache;
+        _cache = nullptr;
+    }
+
+    static void SumThreadCounters(uint64& allocations, uint64& deallocations)
+    {
+        Shared& shared = GetShared(nullptr);
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        allocations = shared.RetiredAllocations;
+        deallocations = shared.RetiredDeallocations;
+        for (ThreadCache const* cache : shared.Caches)
+        {
+            allocations += cache->Allocations.load(std::memory_order_relaxed);
+            deallocations += cache->Deallocations.load(std::memory_order_relaxed);
+        }
+    }
+
+    static Slot* NewSlab(Shared& shared)
+    {
+        Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * SlotsPerSlab));
+        for (uint32 i = 0; i < SlotsPerSlab; ++i)
+            slab[i].Next = i + 1 < SlotsPerSlab ? &slab[i + 1] : nullptr;
+        shared.Stats.Slabs.fetch_add(1, std::memory_order_relaxed);
+        return slab;
+    }
+
+    static void Refill(Shared& shared, ThreadCache& cache)
+    {
+        {
+            std::lock_guard<std::mutex> lock(shared.Lock);
+            if (!shared.Batches.empty())
+            {
+                cache.FreeSlots = shared.Batches.back().Head;
+                cache.FreeSlotCount = shared.Batches.back().Count;
+                shared.Batches.pop_back();
+                shared.Stats.SharedRefills.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        cache.FreeSlots = NewSlab(shared);
+        cache.FreeSlotCount = SlotsPerSlab;
+    }
+
+    static void* AllocateShared(Shared& shared)
+    {
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        ++shared.RetiredAllocations;
+        if (shared.Batches.empty())
+            shared.Batches.push_back({ NewSlab(shared), SlotsPerSlab });
+
+        Batch& batch = shared.Batches.back();
+        Slot* slot = batch.Head;
+        batch.Head = slot->Next;
+        if (!--batch.Count)
+            shared.Batches.pop_back();
+        return slot;
+    }
+
+    static void DeallocateShared(Shared& shared, Slot* slot)
+    {
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        ++shared.RetiredDeallocations;
+        slot->Next = nullptr;
+        shared.Batches.push_back({ slot, 1 });
+    }
+
+    // trivial thread locals, so that they can still be checked after the guard is destroyed
+    static thread_local ThreadCache* _cache;
+    static thread_local bool _threadEnded;
+    static thread_local ThreadCacheGuard _cacheGuard;
+};
+
+template<class T, size_t SlotSize, uint32 SlotsPerSlab>
+thread_local typename ObjectPool<T, SlotSize, SlotsPerSlab>::ThreadCache* ObjectPool<T, SlotSize, SlotsPerSlab>::_cache = nullptr;
+
+template<class T, size_t SlotSize, uint32 SlotsPerSlab>
+thread_local bool ObjectPool<T, SlotSize, SlotsPerSlab>::_threadEnded = false;
+
+template<class T, size_t SlotSize, uint32 SlotsPerSlab>
+thread_local typename ObjectPool<T, SlotSize, SlotsPerSlab>::ThreadCacheGuard ObjectPool<T, SlotSize, SlotsPerSlab>::_cacheGuard;
+
+#endif
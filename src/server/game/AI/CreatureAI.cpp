@@ -99,6 +99,10 @@ void CreatureAI::MoveInLineOfSight(Unit* who)
     if (!me->HasReactState(REACT_AGGRESSIVE))
         return;
 
+    // already fighting, only units coming in melee range are engaged: check it before the costly aggro checks
+    if (me->GetVictim() && !me->IsWithinMeleeRange(who))
+        return;
+
     CanAttackResult result = me->CanAggro(who, false);
     if (result != CAN_ATTACK_RESULT_OK)
         return;
@@ -120,11 +124,8 @@ void CreatureAI::MoveInLineOfSight(Unit* who)
 
         me->EngageWithTarget(who);
     } else {
-        // else just enter combat with it if in melee range
-        if(me->IsWithinMeleeRange(who))
-        {
-            me->EngageWithTarget(who);
-        }
+        // else just enter combat with it, in melee range checked above
+        me->EngageWithTarget(who);
     }
 }
 
@@ -707,30 +707,47 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket *data, ObjectGuid p)
+void Channel::FindMembersInWorld(std::vector<Player*>& members, ObjectGuid except) const
 {
-    for(auto & player : players)
+    members.reserve(players.size());
+
+    // one lookup lock for the whole channel, instead of one per member
+    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+    HashMapHolder<Player>::MapType const& onlinePlayers = ObjectAccessor::GetPlayers();
+    for (auto const& player : players)
     {
-        Player *plr = ObjectAccessor::FindPlayer(player.first);
-        if(plr)
-        {
-            if(!p || !plr->GetSocial()->HasIgnore(p.GetCounter()))
-                plr->SendDirectMessage(data);
-        }
+        if (player.first == except)
+            continue;
+
+        auto itr = onlinePlayers.find(player.first);
+        if (itr != onlinePlayers.end() && itr->second->IsInWorld())
+            members.push_back(itr->second);
     }
 }
 
+void Channel::SendToAll(WorldPacket *data, ObjectGuid p)
+{
+    std::vector<Player*> members;
+    FindMembersInWorld(members);
+
+    // sender is usually ignored by nobody, skip the per member checks then
+    bool checkIgnore = p && sSocialMgr->IsIgnoredByAnyone(p.GetCounter());
+
+    // built once, payload is shared by all member sockets
+    std::shared_ptr<WorldPacket const> packet = std::make_shared<WorldPacket const>(*data);
+    for (Player* plr : members)
+        if (!checkIgnore || !plr->GetSocial()->HasIgnore(p.GetCounter()))
+            plr->GetSession()->SendPacket(packet);
+}
+
 void Channel::SendToAllButOne(WorldPacket *data, ObjectGuid who)
 {
-    for(auto & player : players)
-    {
-        if(player.first != who)
-        {
-            Player *plr = ObjectAccessor::FindPlayer(player.first);
-            if(plr)
-                plr->SendDirectMessage(data);
-        }
-    }
+    std::vector<Player*> members;
+    FindMembersInWorld(members, who);
+
+    std::shared_ptr<WorldPacket const> packet = std::make_shared<WorldPacket const>(*data);
+    for (Player* plr : members)
+        plr->GetSession()->SendPacket(packet);
 }
 
 void Channel::SendToOne(WorldPacket *data, ObjectGuid who)
@@ -181,6 +181,8 @@ class Channel
         void MakeVoiceOn(WorldPacket *data, ObjectGuid guid);                       //+ 0x22
         void MakeVoiceOff(WorldPacket *data, ObjectGuid guid);                      //+ 0x23
 
+        // members in world, resolved under a single lookup lock
+        void FindMembersInWorld(std::vector<Player*>& members, ObjectGuid except = ObjectGuid::Empty) const;
         void SendToAllButOne(WorldPacket *data, ObjectGuid who);
         void SendToOne(WorldPacket *data, ObjectGuid who);
 
@@ -287,6 +287,7 @@ std::vector<ChatCommand> const& ChatHandler::getCommandTable()
         { "getarmor",       SEC_GAMEMASTER3,  false, &ChatHandler::HandleDebugGetArmorCommand,         "" },
         { "spawnbatchobjects",SEC_SUPERADMIN, false, &ChatHandler::HandleSpawnBatchObjects,            "" },
         { "boundary",      SEC_GAMEMASTER3,   false, &ChatHandler::HandleDebugBoundaryCommand,         "" },
+        { "pools",          SEC_GAMEMASTER3,  true,  &ChatHandler::HandleDebugPoolsCommand,            "" },
     };
 
     static std::vector<ChatCommand> eventCommandTable =
@@ -16,6 +16,118 @@
 
 const CompareThreatLessThan ThreatManager::CompareThreat;
 
+void ThreatListHeap::Place(size_t index, ThreatReference* ref)
+{
+    _heap[index] = ref;
+    ref->_heapIndex = index;
+}
+
+void ThreatListHeap::SiftUp(size_t index)
+{
+    ThreatReference* ref = _heap[index];
+    while (index > 0)
+    {
+        size_t const parent = Parent(index);
+        if (!CompareThreatLessThan()(_heap[parent], ref))
+            break;
+        Place(index, _heap[parent]);
+        index = parent;
+    }
+    Place(index, ref);
+}
+
+void ThreatListHeap::SiftDown(size_t index)
+{
+    ThreatReference* ref = _heap[index];
+    size_t const count = _heap.size();
+    for (;;)
+    {
+        size_t const first = FirstChild(index);
+        if (first >= count)
+            break;
+        size_t highest = first;
+        for (size_t child = first + 1; child < std::min(first + ARITY, count); ++child)
+            if (CompareThreatLessThan()(_heap[highest], _heap[child]))
+                highest = child;
+        if (!CompareThreatLessThan()(ref, _heap[highest]))
+            break;
+        Place(index, _heap[highest]);
+        index = highest;
+    }
+    Place(index, ref);
+}
+
+void ThreatListHeap::push(ThreatReference* ref)
+{
+    _heap.push_back(ref);
+    ref->_heapIndex = _heap.size() - 1;
+    SiftUp(ref->_heapIndex);
+}
+
+void ThreatListHeap::erase(ThreatReference* ref)
+{
+    size_t const index = ref->_heapIndex;
+    ASSERT(index < _heap.size() && _heap[index] == ref);
+    ThreatReference* last = _heap.back();
+    _heap.pop_back();
+    if (last == ref)
+        return;
+    Place(index, last);
+    update(last);
+}
+
+void ThreatListHeap::increase(ThreatReference* ref)
+{
+    SiftUp(ref->_heapIndex);
+}
+
+void ThreatListHeap::decrease(ThreatReference* ref)
+{
+    SiftDown(ref->_heapIndex);
+}
+
+void ThreatListHeap::update(ThreatReference* ref)
+{
+    size_t const index = ref->_heapIndex;
+    SiftUp(index);
+    if (ref->_heapIndex == index)
+        SiftDown(index);
+}
+
+ThreatListHeap::ordered_iterator::ordered_iterator(ThreatListHeap const* heap) : _heap(heap)
+{
+    if (!_heap->empty())
+    {
+        _candidates.reserve(ARITY * 2);
+        _candidates.push_back(0);
+    }
+}
+
+bool ThreatListHeap::ordered_iterator::CompareIndex(size_t a, size_t b) const
+{
+    return CompareThreatLessThan()(_heap->_heap[a], _heap->_heap[b]);
+}
+
+ThreatReference const* ThreatListHeap::ordered_iterator::operator*() const
+{
+    return _heap->_heap[_candidates.front()];
+}
+
+ThreatListHeap::ordered_iterator& ThreatListHeap::ordered_iterator::operator++()
+{
+    auto compare = [this](size_t a, size_t b) { return CompareIndex(a, b); };
+    size_t const first = FirstChild(_candidates.front());
+    std::pop_heap(_candidates.begin(), _candidates.end(), compare);
+    _candidates.pop_back();
+    // children of the entry just visited are the only new entries that can come next
+    for (size_t child = first; child < std::min(first + ARITY, _heap->size()); ++child)
+    {
+        _candidates.push_back(child);
+        std::push_heap(_candidates.begin(), _candidates.end(), compare);
+    }
+    return *this;
+}
+
 void ThreatReference::AddThreat(float amount)
 {
     if (amount == 0.0f)
@@ -395,7 +507,7 @@ void ThreatManager::MatchUnitThreatToHighestThreat(Unit* target)
 
 void ThreatManager::TauntUpdate()
 {
-    std::list<AuraEffect*> const& tauntEffects = _owner->GetAuraEffectsByType(SPELL_AURA_MOD_TAUNT);
+    Unit::AuraEffectList const& tauntEffects = _owner->GetAuraEffectsByType(SPELL_AURA_MOD_TAUNT);
 
     uint32 state = ThreatReference::TAUNT_STATE_TAUNT;
     std::unordered_map<ObjectGuid, ThreatReference::TauntState> tauntStates;
@@ -705,7 +817,7 @@ void ThreatManager::PutThreatListRef(ObjectGuid const& guid, ThreatReference* re
     auto& inMap = _myThreatListEntries[guid];
     ASSERT(!inMap, "Duplicate threat reference at %p being inserted on %s for %s - memory leak!", ref, _owner->GetGUID().ToString().c_str(), guid.ToString().c_str());
     inMap = ref;
-    ref->_handle = _sortedThreatList.push(ref);
+    _sortedThreatList.push(ref);
 }
 
 void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid, bool sendRemove)
@@ -721,7 +833,7 @@ void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid, bool sendRemove)
     if (_fixateRef == ref)
         _fixateRef = nullptr;
     
-    _sortedThreatList.erase(ref->_handle);
+    _sortedThreatList.erase(ref);
     if (sendRemove && ref->IsAvailable())
         SendRemoveToClients(ref->_victim);
 }
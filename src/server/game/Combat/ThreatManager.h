@@ -6,7 +6,6 @@
 #include "IteratorPair.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
-#include <boost/heap/fibonacci_heap.hpp>
 #include <array>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +36,8 @@ class SpellInfo;
  *                                                                                                                                                      *
  * To manage a creature's threat list, ThreatManager maintains a heap of threat reference const pointers.                                               *
  * This heap is kept well-structured in all methods that modify ThreatReference, and is used to select the next target.                                 *
+ * It is a 4-ary heap in a flat array (see ThreatListHeap): threat mostly changes by small increments which rarely move an entry, and selection only    *
+ * needs the top entry, or the top few ones which sorted iteration walks lazily.                                                                        *
  *                                                                                                                                                      *
  * Selection uses the following properties on ThreatReference, in order:                                                                                *
  * - Online state (one of ONLINE, SUPPRESSED, OFFLINE):                                                                                                 *
@@ -65,11 +66,63 @@ struct CompareThreatLessThan
     bool operator()(ThreatReference const* a, ThreatReference const* b) const;
 };
 
+// Max heap of threat references with arity 4, stored in a vector. Each reference knows its own position so it can be moved in place when its threat changes.
+class TC_GAME_API ThreatListHeap
+{
+    public:
+        static const size_t ARITY = 4;
+        typedef std::vector<ThreatReference*>::const_iterator iterator;
+
+        // Walks the heap from highest to lowest without modifying it, expanding only the visited entries. First entries are cheap, a full walk is O(n log n)
+        class ordered_iterator
+        {
+            public:
+                ordered_iterator() : _heap(nullptr) { }
+                explicit ordered_iterator(ThreatListHeap const* heap);
+
+                ThreatReference const* operator*() const;
+                ordered_iterator& operator++();
+                bool operator==(ordered_iterator const& o) const { return _candidates.empty() ? o._candidates.empty() : (!o._candidates.empty() && _candidates.front() == o._candidates.front()); }
+                bool operator!=(ordered_iterator const& o) const { return !(*this == o); }
+
+            private:
+                bool CompareIndex(size_t a, size_t b) const;
+
+                ThreatListHeap const* _heap;
+                std::vector<size_t> _candidates; // heap indexes whose parents were already visited, itself a binary heap
+        };
+
+        bool empty() const { return _heap.empty(); }
+        size_t size() const { return _heap.size(); }
+        ThreatReference const* top() const { return _heap.front(); }
+        // unordered iteration
+        iterator begin() const { return _heap.begin(); }
+        iterator end() const { return _heap.end(); }
+        ordered_iterator ordered_begin() const { return ordered_iterator(this); }
+        ordered_iterator ordered_end() const { return ordered_iterator(); }
+
+        void push(ThreatReference* ref);
+        void erase(ThreatReference* ref);
+        // call after ref moved up, down or in an unknown direction in the threat list
+        void increase(ThreatReference* ref);
+        void decrease(ThreatReference* ref);
+        void update(ThreatReference* ref);
+
+    private:
+        static size_t Parent(size_t index) { return (index - 1) / ARITY; }
+        static size_t FirstChild(size_t index) { return index * ARITY + 1; }
+        void Place(size_t index, ThreatReference* ref);
+        void SiftUp(size_t index);
+        void SiftDown(size_t index);
+
+        std::vector<ThreatReference*> _heap;
+};
+
 // Please check Game/Combat/ThreatManager.h for documentation on how this class works!
 class TC_GAME_API ThreatManager
 {
     public:
-        typedef boost::heap::fibonacci_heap<ThreatReference const*, boost::heap::compare<CompareThreatLessThan>> threat_list_heap;
+        typedef ThreatListHeap threat_list_heap;
         class ThreatListIterator;
         static const uint32 CLIENT_THREAT_UPDATE_INTERVAL = 1000u;
 
@@ -258,27 +311,28 @@ class TC_GAME_API ThreatReference
         void ClearThreat(bool sendRemove = true); // dealloc's this
 
     private:
-        ThreatReference(ThreatManager* mgr, Unit* victim, float amount) : _owner(mgr->_owner), _mgr(mgr), _victim(victim), _baseAmount(amount), _tempModifier(0), _online(SelectOnlineState()), _taunted(TAUNT_STATE_NONE) { }
+        ThreatReference(ThreatManager* mgr, Unit* victim, float amount) : _owner(mgr->_owner), _mgr(mgr), _victim(victim), _baseAmount(amount), _tempModifier(0), _online(SelectOnlineState()), _taunted(TAUNT_STATE_NONE), _heapIndex(0) { }
         static bool FlagsAllowFighting(Unit const* a, Unit const* b);
         OnlineState SelectOnlineState();
         void UpdateTauntState(TauntState state = TAUNT_STATE_NONE);
         Unit* const _owner;
         ThreatManager* const _mgr;
-        void HeapNotifyIncreased() { _mgr->_sortedThreatList.increase(_handle); }
-        void HeapNotifyDecreased() { _mgr->_sortedThreatList.decrease(_handle); }
-        void HeapNotifyChanged() { _mgr->_sortedThreatList.update(_handle); }
+        void HeapNotifyIncreased() { _mgr->_sortedThreatList.increase(this); }
+        void HeapNotifyDecreased() { _mgr->_sortedThreatList.decrease(this); }
+        void HeapNotifyChanged() { _mgr->_sortedThreatList.update(this); }
         Unit* const _victim;
         float _baseAmount;
         int32 _tempModifier; // Temporary effects (auras with SPELL_AURA_MOD_TOTAL_THREAT) - set from victim's threatmanager in ThreatManager::UpdateMyTempModifiers
         OnlineState _online;
         TauntState _taunted;
-        ThreatManager::threat_list_heap::handle_type _handle;
+        size_t _heapIndex; // position in owner's ThreatListHeap
 
     public:
         ThreatReference(ThreatReference const&) = delete;
         ThreatReference& operator=(ThreatReference const&) = delete;
 
     friend class ThreatManager;
+    friend class ThreatListHeap;
     friend struct CompareThreatLessThan;
 };
 
@@ -1,5 +1,6 @@
 #include "Chat.h"
 #include "Language.h"
+#include "ObjectPool.h"
 #include <fstream>
 #include "UpdateFieldsDebug.h"
 #include "BattleGroundMgr.h"
@@ -1484,6 +1485,21 @@ bool ChatHandler::HandleDebugBoundaryCommand(char const* args)
     return true;
 }
 
+/* .debug pools
+Show allocation statistics of object pools (spells, auras...) */
+bool ChatHandler::HandleDebugPoolsCommand(const char* /*args*/)
+{
+    for (ObjectPoolStats const* stats : sObjectPoolRegistry->GetPools())
+    {
+        uint64 allocations, deallocations;
+        stats->SumThreadCounters(allocations, deallocations);
+        uint64 const slabs = stats->Slabs;
+        PSendSysMessage("%s (%u bytes): %u in use, %u allocations, %u slabs (%u KB), %u oversized, %u shared refills",
+            stats->Name, uint32(stats->SlotSize), uint32(allocations - deallocations), uint32(allocations), uint32(slabs),
+            uint32(slabs * stats->SlotsPerSlab * stats->SlotSize / 1024), uint32(stats->OversizedAllocations), uint32(stats->SharedRefills));
+    }
+    return true;
+}
 
 /* Spawn a bunch of gameobjects objects from given file. This command will check wheter a close object is found on this server and ignore the new one if one is found.
 A preview gobject is spawned.
@@ -180,6 +180,8 @@ bool ChatHandler::HandleServerInfoCommand(const char* /*args*/)
     PSendSysMessage("Smoothed update time diff: %u.", sMonitor->GetSmoothTimeDiff());
     PSendSysMessage("Instant update time diff: %u.", sWorld->GetUpdateTime());
     PSendSysMessage("Current map update time diff: %u.", currentMapTimeDiff);
+    if (sMonitor->GetLineOfSightCacheHitRate() >= 0)
+        PSendSysMessage("Line of sight cache hit rate: %i%%.", sMonitor->GetLineOfSightCacheHitRate());
     if (sWorld->IsShuttingDown())
         PSendSysMessage("Server restart in %s", secsToTimeString(sWorld->GetShutDownTimeLeft()).c_str());
 
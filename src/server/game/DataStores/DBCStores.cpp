@@ -1,4 +1,5 @@
 #include "DBCStores.h"
+#include "DBCCache.h"
 #include "Log.h"
 #include "TransportMgr.h"
 #include "Item.h"
@@ -10,6 +11,10 @@
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <boost/filesystem/operations.hpp>
+
+// defined before the stores, records loaded from the cache point into it
+static std::unique_ptr<DBCCache> sDBCCache;
 
 typedef std::map<uint16,uint32> AreaFlagByAreaID;
 typedef std::map<uint32,uint32> AreaFlagByMapID;
@@ -164,6 +169,7 @@ DBCStorage <WorldSafeLocsEntry> sWorldSafeLocsStore(WorldSafeLocsEntryfmt);
 typedef std::list<std::string> StoreProblemList;
 
 uint32 DBCFileCount = 0;
+static std::string DBCFilesStamp;
 
 static bool LoadDBC_assert_print(uint32 fsize,uint32 rsize, const std::string& filename)
 {
@@ -174,8 +180,33 @@ static bool LoadDBC_assert_print(uint32 fsize,uint32 rsize, const std::string& f
 }
 
 
+// Identifies a file a store is built from, so that its DBC cache section is rebuilt when the file changes
+static bool AppendDBCFileStamp(std::string& stamp, std::string const& path)
+{
+    boost::system::error_code error;
+    uintmax_t size = boost::filesystem::file_size(path, error);
+    if (error)
+    {
+        stamp += path + ":missing;";
+        return false;
+    }
+
+    std::time_t time = boost::filesystem::last_write_time(path, error);
+    stamp += Trinity::StringFormat("%s:" UI64FMTD ":" UI64FMTD ";", path.c_str(), uint64(size), uint64(time));
+    return true;
+}
+
+static std::string GetLocalizedDBCPath(std::string const& dbcPath, uint8 locale, std::string const& filename)
+{
+    std::string localizedName(dbcPath);
+    localizedName.append(localeNames[locale]);
+    localizedName.push_back('/');
+    localizedName.append(filename);
+    return localizedName;
+}
+
 template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const& customFormat = std::string(), std::string const& customIndexName = std::string())
+inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, DBCCache* cache, std::string const& customFormat = std::string(), std::string const& customIndexName = std::string())
 {
     // compatibility format and C++ structure sizes
     ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
@@ -183,6 +214,23 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     ++DBCFileCount;
     std::string dbcFilename = dbcPath + filename;
 
+    std::string stamp = Trinity::StringFormat("%s:%u;", storage.GetFormat(), uint32(sizeof(T)));
+    AppendDBCFileStamp(stamp, dbcFilename);
+
+    uint32 stampedLocales = availableDbcLocales;
+    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        if ((availableDbcLocales & (1 << i)) && !AppendDBCFileStamp(stamp, GetLocalizedDBCPath(dbcPath, i, filename)))
+            stampedLocales &= ~(1 << i);
+
+    DBCFilesStamp += stamp;
+
+    // stores with database overrides are always loaded from dbc files and database
+    if (cache && customFormat.empty() && cache->LoadStore(storage, filename, stamp))
+    {
+        availableDbcLocales = stampedLocales;
+        return;
+    }
+
     if (storage.Load(dbcFilename))
     {
         for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
@@ -190,17 +238,14 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
             if (!(availableDbcLocales & (1 << i)))
                 continue;
 
-            std::string localizedName(dbcPath);
-            localizedName.append(localeNames[i]);
-            localizedName.push_back('/');
-            localizedName.append(filename);
-
-            if (!storage.LoadStringsFrom(localizedName))
+            if (!storage.LoadStringsFrom(GetLocalizedDBCPath(dbcPath, i, filename)))
                 availableDbcLocales &= ~(1 << i);             // mark as not available for speedup next checks
         }
 
         if (!customFormat.empty())
             storage.LoadFromDB(filename, customFormat, customIndexName);
+        else if (cache)
+            cache->AddStore(storage, filename, stamp);
     }
     else
     {
@@ -218,16 +263,26 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     }
 }
 
-void LoadDBCStores(const std::string& dataPath)
+void LoadDBCStores(const std::string& dataPath, std::string const& cacheFile)
 {
+    DBCFilesStamp.clear();
     std::string dbcPath = dataPath+"dbc/";
 
+    DBCCache* cache = nullptr;
+    if (!cacheFile.empty())
+    {
+        sDBCCache = std::make_unique<DBCCache>(dataPath + cacheFile);
+        if (!sDBCCache->Open())
+            TC_LOG_INFO("server.loading", "DBC cache %s%s not found or outdated, building it from dbc files", dataPath.c_str(), cacheFile.c_str());
+        cache = sDBCCache.get();
+    }
+
     const uint32 DBCFilesCount = 58;
 
     StoreProblemList bad_dbc_files;
     uint32 availableDbcLocales = 0xFFFFFFFF;
 
-#define LOAD_DBC(store, file) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file)
+#define LOAD_DBC(store, file) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, cache)
 
     LOAD_DBC(sAreaTableStore, "AreaTable.dbc");
     LOAD_DBC(sAreaTriggerStore, "AreaTrigger.dbc");
@@ -265,7 +320,7 @@ void LoadDBCStores(const std::string& dataPath)
     }
 
     LOAD_DBC(sFactionTemplateStore, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGameObjectDisplayInfoStore,  dbcPath, "GameObjectDisplayInfo.dbc");
+    LoadDBC(availableDbcLocales, bad_dbc_files, sGameObjectDisplayInfoStore,  dbcPath, "GameObjectDisplayInfo.dbc", cache);
     for (uint32 i = 0; i < sGameObjectDisplayInfoStore.GetNumRows(); ++i)
     {
         if (GameObjectDisplayInfoEntry const* info = sGameObjectDisplayInfoStore.LookupEntry(i))
@@ -287,7 +342,7 @@ void LoadDBCStores(const std::string& dataPath)
 
     LOAD_DBC(sGtChanceToSpellCritBaseStore, "gtChanceToSpellCritBase.dbc");
     LOAD_DBC(sGtChanceToSpellCritStore, "gtChanceToSpellCrit.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtNPCManaCostScalerStore, dbcPath, "gtNPCManaCostScaler.dbc");
+    LoadDBC(availableDbcLocales,bad_dbc_files,sGtNPCManaCostScalerStore, dbcPath, "gtNPCManaCostScaler.dbc", cache);
 
     LOAD_DBC(sGtOCTRegenHPStore, "gtOCTRegenHP.dbc");
     //LOAD_DBC(sGtOCTRegenMPStore, "gtOCTRegenMP.dbc");       -- not used currently
@@ -539,6 +594,13 @@ void LoadDBCStores(const std::string& dataPath)
         exit(1);
     }
 
+    if (cache)
+    {
+        TC_LOG_INFO("server.loading", ">> Loaded %u data stores from DBC cache", cache->GetLoadedStoreCount());
+        if (cache->GetAddedStoreCount())
+            cache->Save();
+    }
+
     TC_LOG_INFO("server.loading", ">> Loaded %d data stores", DBCFilesCount );
 }
 
@@ -951,6 +1013,10 @@ uint32 GetDefaultMapLight(uint32 mapId)
     return 0;
 }
 
+std::string const& GetDBCFilesStamp()
+{
+    return DBCFilesStamp;
+}
 
 // script support functions
 DBCStorage <SoundEntriesEntry>  const* GetSoundEntriesStore()   { return &sSoundEntriesStore;   }
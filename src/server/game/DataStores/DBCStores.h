@@ -139,7 +139,9 @@ TC_GAME_API extern DBCStorage <WMOAreaTableEntry>            sWMOAreaTableStore;
 //TC_GAME_API extern DBCStorage <WorldMapAreaEntry>           sWorldMapAreaStore; -- use Zone2MapCoordinates and Map2ZoneCoordinates
 TC_GAME_API extern DBCStorage <WorldSafeLocsEntry>           sWorldSafeLocsStore;
 
-void LoadDBCStores(const std::string& dataPath);
+void LoadDBCStores(const std::string& dataPath, std::string const& cacheFile = std::string());
+// Format, size and modification time of every loaded dbc file, including locales. Changes when dbc files are extracted again from another client
+TC_GAME_API std::string const& GetDBCFilesStamp();
 
 // script support functions
 TC_GAME_API DBCStorage <SoundEntriesEntry>  const* GetSoundEntriesStore();
@@ -1984,7 +1984,7 @@ bool Creature::CanAlwaysSee(WorldObject const* obj) const
     return false;
 }
 
-CanAttackResult Creature::CanAggro(Unit const* who, bool force /* = false */) const
+CanAttackResult Creature::CanAggro(Unit const* who, bool force /* = false */, bool checkLineOfSight /* = true */) const
 {
     if(IsCivilian())
         return CAN_ATTACK_RESULT_CIVILIAN;
@@ -2001,15 +2001,12 @@ CanAttackResult Creature::CanAggro(Unit const* who, bool force /* = false */) co
         if(!IsWithinSightDist(who))
             return CAN_ATTACK_RESULT_TOO_FAR;
     } else {
-        if (!_IsTargetAcceptable(who))
-            return CAN_ATTACK_RESULT_OTHERS;
-
+        // called for every unit moving around, cheapest checks first: distance, then factions, vmap line of sight last
         if(!IsWithinDistInMap(who, GetAggroRange(who) + m_CombatDistance + GetCombatReach() + who->GetCombatReach())) //m_CombatDistance is usually 0 for melee. Ranged creatures will aggro from further, is this correct?
             return CAN_ATTACK_RESULT_TOO_FAR;
 
-        //ignore LoS for assist
-        if (!IsWithinLOSInMap(who))
-            return CAN_ATTACK_RESULT_NOT_IN_LOS;
+        if (!_IsTargetAcceptable(who))
+            return CAN_ATTACK_RESULT_OTHERS;
     }
 
     CanAttackResult result = CanCreatureAttack(who, false);
@@ -2019,6 +2016,10 @@ CanAttackResult Creature::CanAggro(Unit const* who, bool force /* = false */) co
     if (!who->isInAccessiblePlaceFor(this))
         return CAN_ATTACK_RESULT_NOT_ACCESSIBLE;
 
+    //ignore LoS for assist
+    if (!force && checkLineOfSight && !IsWithinLOSInMap(who))
+        return CAN_ATTACK_RESULT_NOT_IN_LOS;
+
     return CAN_ATTACK_RESULT_OK;
 }
 
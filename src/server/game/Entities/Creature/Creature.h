@@ -376,7 +376,6 @@ struct CreatureData : public SpawnData
     uint32 curmana = 0;
     uint8 movementType = 0;
     uint32 poolId = 0; //old windrunner link system
-    uint32 scriptId = 0;
     uint32 instanceEventId = 0; // If spawned in raid, don't respawn if corresponding instance event is != NOT_STARTED (creature_encounter_respawn table)
 };
 
@@ -706,8 +705,9 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         bool IsWithinSightDist(Unit const* u) const;
         /* Return if creature can aggro and start attacking target, depending on faction, distance, LoS, if target is attackable, ...
         @skip los and distance check instead of standard aggro.
+        @checkLineOfSight false to run every other check, for callers resolving line of sight of several units at once
         */
-        CanAttackResult CanAggro(Unit const* u, bool force = false) const;
+        CanAttackResult CanAggro(Unit const* u, bool force = false, bool checkLineOfSight = true) const;
         float GetAggroRange(Unit const* pl) const;
         
         /** The "suspicious look" is a warning whenever a stealth player is about to be detected by a creature*/
@@ -1109,6 +1109,8 @@ void GameObject::EnableCollision(bool enable)
         return;
 
     m_model->enable(enable);
+    if (IsInWorld())
+        GetMap()->InvalidateLineOfSightCache(m_model->getBounds());
 }
 
 void GameObject::UpdateModel()
@@ -2011,7 +2013,7 @@ void GameObject::EventInform(uint32 eventId)
 uint32 GameObject::GetScriptId() const
 {
     if (GameObjectData const* gameObjectData = GetGameObjectData())
-        if (uint32 scriptId = gameObjectData->ScriptId)
+        if (uint32 scriptId = gameObjectData->scriptId)
             return scriptId;
 
     return GetGOInfo()->ScriptId;
@@ -436,7 +436,6 @@ struct GameObjectData : public SpawnData
     uint32 animprogress;
     uint32 go_state;
     uint32 ArtKit;
-    uint32 ScriptId;
 };
 
 // GCC have alternative #pragma pack() syntax and old gcc version not support pack(pop), also any gcc version not support it at some platform
@@ -1131,6 +1131,12 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, LineOfSightChecks che
     if (!IsInMap(obj)) 
         return false;
 
+    VMAP::LineOfSightSegment const segment = GetLineOfSightSegment(obj);
+    return GetMap()->isInLineOfSight(segment.x1, segment.y1, segment.z1, segment.x2, segment.y2, segment.z2, GetPhaseMask(), checks, ignoreFlags);
+}
+
+VMAP::LineOfSightSegment WorldObject::GetLineOfSightSegment(WorldObject const* obj) const
+{
     float ox, oy, oz;
     if (obj->GetTypeId() == TYPEID_PLAYER)
     {
@@ -1149,29 +1155,35 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, LineOfSightChecks che
     else
         GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, x, y, z);
 
-    return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks, ignoreFlags);
+    return { x, y, z, ox, oy, oz };
 }
 
 bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if(IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        
-        return GetMap()->isInLineOfSight(x, y, z + 2.0f, ox, oy, oz + 2.0f, GetPhaseMask(), checks, ignoreFlags);
+        VMAP::LineOfSightSegment const segment = GetLineOfSightSegment(ox, oy, oz);
+        return GetMap()->isInLineOfSight(segment.x1, segment.y1, segment.z1, segment.x2, segment.y2, segment.z2, GetPhaseMask(), checks, ignoreFlags);
    }
     
     return true;
 }
 
+VMAP::LineOfSightSegment WorldObject::GetLineOfSightSegment(float ox, float oy, float oz) const
+{
+    oz += GetCollisionHeight();
+    float x, y, z;
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(x, y, z);
+        z += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
+
+    return { x, y, z + 2.0f, ox, oy, oz + 2.0f };
+}
+
 Position WorldObject::GetHitSpherePointFor(Position const& dest) const
 {
     G3D::Vector3 vThis(GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight());
@@ -1385,12 +1397,18 @@ float WorldObject::SelectBestZForDestination(float x, float y, float z, bool exc
     float const myCollisionHeight = GetCollisionHeight();
     float const destCollisionHeight = excludeCollisionHeight ? 0.0f : myCollisionHeight;
 
-    float const myGridHeight = GetMap()->GetGridMapHeight(myX, myY);
+    // both points are usually in the same grid
+    float const gridX[2] = { myX, x };
+    float const gridY[2] = { myY, y };
+    float gridHeights[2];
+    GetMap()->GetGridMapHeights(gridX, gridY, gridHeights, 2);
+
+    float const myGridHeight = gridHeights[0];
     float const myVmapFloor = std::max(GetMap()->GetVMapFloor(myX, myY, myZ, 150.0f, myCollisionHeight),
         GetMap()->GetGameObjectFloor(GetPhaseMask(), myX, myY, myZ, 150.0f, myCollisionHeight));
 
     // which of these 3 do I want ?
-    float const destGridHeight = GetMap()->GetGridMapHeight(x, y);
+    float const destGridHeight = gridHeights[1];
     float const destCeil = GetMap()->GetCeil(GetPhaseMask(), x, y, z, 150.0f, destCollisionHeight);
     float const destVmapFloor = std::max(GetMap()->GetVMapFloor(x, y, z, 150.0f, destCollisionHeight),
         GetMap()->GetGameObjectFloor(GetPhaseMask(), x, y, z, 150.0f, destCollisionHeight));
@@ -502,6 +502,10 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D = true) const;
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // Segment checked by IsWithinLOS(x, y, z)
+        VMAP::LineOfSightSegment GetLineOfSightSegment(float x, float y, float z) const;
+        // Segment checked by IsWithinLOSInMap(obj)
+        VMAP::LineOfSightSegment GetLineOfSightSegment(WorldObject const* obj) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
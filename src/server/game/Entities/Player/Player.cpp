@@ -209,6 +209,9 @@ Player::Player(WorldSession *session) :
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
     m_auraUpdateMask = 0;
+    m_groupUpdateTimer = 0;
+    m_groupUpdateSentMask = 0;
+    m_groupUpdateSentValues.fill(0);
 
     duel = nullptr;
 
@@ -1435,7 +1438,7 @@ void Player::Update( uint32 p_time )
     UpdateHomebindTime(p_time);
 
     // group update
-    SendUpdateToOutOfRangeGroupMembers();
+    SendUpdateToOutOfRangeGroupMembers(p_time);
 
     Pet* pet = GetPet();
     if(pet && !IsWithinDistInMap(pet, OWNER_MAX_DISTANCE) && !pet->IsPossessed())
@@ -20327,6 +20330,17 @@ inline void BeforeVisibilityDestroy<Creature>(Creature* t, Player* p)
         t->ToPet()->Remove(PET_SAVE_NOT_IN_SLOT, true);
 }
 
+template<class T>
+inline void OnVisibilityChange(T* /*t*/, Player* /*p*/) { }
+
+template<>
+inline void OnVisibilityChange<Player>(Player* t, Player* p)
+{
+    // p receives t values through object updates while in range, values t sent out of range can't be compared anymore
+    if (p->IsInSameRaidWith(t))
+        t->ResetGroupUpdateSentValues();
+}
+
 void Player::UpdateVisibilityOf(WorldObject* target)
 {
     if(HaveAtClient(target))
@@ -20335,6 +20349,8 @@ void Player::UpdateVisibilityOf(WorldObject* target)
         {
             if (target->GetTypeId() == TYPEID_UNIT)
                 BeforeVisibilityDestroy<Creature>(target->ToCreature(), this);
+            else if (target->GetTypeId() == TYPEID_PLAYER)
+                OnVisibilityChange<Player>(target->ToPlayer(), this);
 
             target->DestroyForPlayer(this);
             m_clientGUIDs.erase(target->GetGUID());
@@ -20348,6 +20364,8 @@ void Player::UpdateVisibilityOf(WorldObject* target)
         {
             target->SendUpdateToPlayer(this);
             m_clientGUIDs.insert(target->GetGUID());
+            if (target->GetTypeId() == TYPEID_PLAYER)
+                OnVisibilityChange<Player>(target->ToPlayer(), this);
 
             //TC_LOG_DEBUG("debug.grid","Object %u (Type: %u) is visible now for player %u. Distance = %f",target->GetGUID().GetCounter(),target->GetTypeId(),GetGUID().GetCounter(),GetDistance(target));
 
@@ -20398,6 +20416,7 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
         if (!CanSeeOrDetect(target, false, true))
         {
             BeforeVisibilityDestroy<T>(target, this);
+            OnVisibilityChange<T>(target, this);
 
             target->BuildOutOfRangeUpdateBlock(&data);
             m_clientGUIDs.erase(target->GetGUID());
@@ -20411,6 +20430,7 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
         {
             target->BuildCreateUpdateBlockForPlayer(&data, this);
             UpdateVisibilityOf_helper(m_clientGUIDs,target, visibleNow);
+            OnVisibilityChange<T>(target, this);
 
             //TC_LOG_DEBUG("debug.grid", "Object %u (Type: %u) is visible now for player %u. Distance = %f", target->GetGUID().GetCounter(), target->GetTypeId(), GetGUID().GetCounter(), GetDistance(target));
         }
@@ -20737,12 +20757,21 @@ bool Player::ValidateAppearance(uint8 race, uint8 class_, uint8 gender, uint8 ha
     return true;
 }
 
-void Player::SendUpdateToOutOfRangeGroupMembers()
+void Player::SendUpdateToOutOfRangeGroupMembers(uint32 diff)
 {
+    // changes are merged until the interval since last update is elapsed
+    if (m_groupUpdateTimer > diff)
+    {
+        m_groupUpdateTimer -= diff;
+        return;
+    }
+    m_groupUpdateTimer = 0;
+
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
+    m_groupUpdateTimer = sWorld->getConfig(CONFIG_GROUP_MEMBER_STATS_UPDATE_INTERVAL);
     if(Group* group = GetGroup())
-        group->UpdatePlayerOutOfRange(this);
+        group->UpdatePlayerOutOfRange(this, true);
 
     m_groupUpdateMask = GROUP_UPDATE_FLAG_NONE;
     m_auraUpdateMask = 0;
@@ -20750,6 +20779,56 @@ void Player::SendUpdateToOutOfRangeGroupMembers()
         pet->ResetAuraUpdateMask();
 }
 
+bool Player::RemoveUnchangedGroupUpdateFlags(std::vector<Player const*> const& recipients)
+{
+    // fields with a single value that can be compared, as written by WorldSession::BuildPartyMemberStatsChangedPacket
+    uint32 const comparableFlags = GROUP_UPDATE_FLAG_CUR_HP | GROUP_UPDATE_FLAG_MAX_HP | GROUP_UPDATE_FLAG_CUR_POWER | GROUP_UPDATE_FLAG_MAX_POWER
+        | GROUP_UPDATE_FLAG_LEVEL | GROUP_UPDATE_FLAG_ZONE | GROUP_UPDATE_FLAG_POSITION;
+
+    // values sent before are only known if the same members received them
+    if (!std::equal(recipients.begin(), recipients.end(), m_groupUpdateRecipients.begin(), m_groupUpdateRecipients.end(),
+        [](Player const* recipient, ObjectGuid const& guid) { return recipient->GetGUID() == guid; }))
+    {
+        ResetGroupUpdateSentValues();
+        for (Player const* recipient : recipients)
+            m_groupUpdateRecipients.push_back(recipient->GetGUID());
+    }
+
+    if (m_groupUpdateMask & GROUP_UPDATE_FLAG_POWER_TYPE) // power is always sent along power type
+        m_groupUpdateMask |= (GROUP_UPDATE_FLAG_CUR_POWER | GROUP_UPDATE_FLAG_MAX_POWER);
+
+    Powers const powerType = GetPowerType();
+    for (uint8 i = 0; i < GROUP_UPDATE_FLAGS_COUNT; ++i)
+    {
+        uint32 const flag = 1 << i;
+        if (!(m_groupUpdateMask & flag & comparableFlags))
+            continue;
+
+        uint32 value = 0;
+        switch (flag)
+        {
+            case GROUP_UPDATE_FLAG_CUR_HP:    value = GetHealth(); break;
+            case GROUP_UPDATE_FLAG_MAX_HP:    value = GetMaxHealth(); break;
+            case GROUP_UPDATE_FLAG_CUR_POWER: value = GetPower(powerType); break;
+            case GROUP_UPDATE_FLAG_MAX_POWER: value = GetMaxPower(powerType); break;
+            case GROUP_UPDATE_FLAG_LEVEL:     value = GetLevel(); break;
+            case GROUP_UPDATE_FLAG_ZONE:      value = GetZoneId(); break;
+            case GROUP_UPDATE_FLAG_POSITION:  value = (uint32(int32(GetPositionX())) & 0xFFFF) | (uint32(int32(GetPositionY())) << 16); break;
+            default: break;
+        }
+
+        if ((m_groupUpdateSentMask & flag) && m_groupUpdateSentValues[i] == value)
+            m_groupUpdateMask &= ~flag;
+        else
+        {
+            m_groupUpdateSentValues[i] = value;
+            m_groupUpdateSentMask |= flag;
+        }
+    }
+
+    return m_groupUpdateMask != GROUP_UPDATE_FLAG_NONE;
+}
+
 void Player::SendTransferAborted(uint32 mapid, uint16 reason)
 {
     WorldPacket data(SMSG_TRANSFER_ABORTED, 4 + 2);
@@ -14,6 +14,7 @@
 #include "SpellMgr.h"
 #include "PlayerTaxi.h"
 
+#include<array>
 #include<string>
 #include<vector>
 
@@ -1781,7 +1782,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void UninviteFromGroup();
         static void RemoveFromGroup(Group* group, ObjectGuid guid, RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT, ObjectGuid kicker = ObjectGuid::Empty, char const* reason = nullptr);
         void RemoveFromGroup(RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT) { RemoveFromGroup(GetGroup(), GetGUID(), method); }
-        void SendUpdateToOutOfRangeGroupMembers();
+        void SendUpdateToOutOfRangeGroupMembers(uint32 diff);
 
         void SetInGuild(uint32 guildId);
         void SetRank(uint32 rankId);
@@ -2352,6 +2353,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint8 GetSubGroup() const { return m_group.getSubGroup(); }
         uint32 GetGroupUpdateFlag() const { return m_groupUpdateMask; }
         void SetGroupUpdateFlag(uint32 flag) { m_groupUpdateMask |= flag; }
+        // Remove flags of values these out of range members already received, returns false if nothing is left to send
+        bool RemoveUnchangedGroupUpdateFlags(std::vector<Player const*> const& recipients);
+        // Forget values sent to out of range members, next update sends all flagged values
+        void ResetGroupUpdateSentValues() { m_groupUpdateSentMask = GROUP_UPDATE_FLAG_NONE; m_groupUpdateRecipients.clear(); }
         uint64 GetAuraUpdateMask() const { return m_auraUpdateMask; }
         void SetAuraUpdateMask(uint8 slot) { m_auraUpdateMask |= (uint64(1) << slot); }
         void UnsetAuraUpdateMask(uint8 slot) { m_auraUpdateMask &= ~(uint64(1) << slot); }
@@ -2639,6 +2644,11 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Group *m_groupInvite;
         uint32 m_groupUpdateMask;
         uint64 m_auraUpdateMask;
+        uint32 m_groupUpdateTimer;
+        // last stats sent to out of range members, by update flag index
+        uint32 m_groupUpdateSentMask;
+        std::array<uint32, GROUP_UPDATE_FLAGS_COUNT> m_groupUpdateSentValues;
+        std::vector<ObjectGuid> m_groupUpdateRecipients;
 
         // Temporarily removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
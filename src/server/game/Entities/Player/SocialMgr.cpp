@@ -70,11 +70,17 @@ bool PlayerSocial::AddToSocialList(ObjectGuid::LowType friend_guid, bool _ignore
     auto itr = m_playerSocialMap.find(friend_guid);
     if(itr != m_playerSocialMap.end())
     {
+        if (_ignore && !(itr->second.Flags & SOCIAL_FLAG_IGNORED))
+            sSocialMgr->AddIgnoredBy(friend_guid);
+
         CharacterDatabase.PExecute("UPDATE character_social SET flags = (flags | %u) WHERE guid = '%u' AND friend = '%u'", flag, GetPlayerGUID(), friend_guid);
         m_playerSocialMap[friend_guid].Flags |= flag;
     }
     else
     {
+        if (_ignore)
+            sSocialMgr->AddIgnoredBy(friend_guid);
+
         CharacterDatabase.PExecute("INSERT INTO character_social (guid, friend, flags) VALUES ('%u', '%u', '%u')", GetPlayerGUID(), friend_guid, flag);
         FriendInfo fi;
         fi.Flags |= flag;
@@ -93,6 +99,9 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid::LowType friend_guid, bool _i
     if(_ignore)
         flag = SOCIAL_FLAG_IGNORED;
 
+    if (_ignore && (itr->second.Flags & SOCIAL_FLAG_IGNORED))
+        sSocialMgr->RemoveIgnoredBy(friend_guid);
+
     itr->second.Flags &= ~flag;
     if(itr->second.Flags == 0)
     {
@@ -182,7 +191,10 @@ void SocialMgr::RemovePlayerSocial(ObjectGuid::LowType guid)
 {
     auto itr = m_socialMap.find(guid);
     if(itr != m_socialMap.end())
+    {
+        RemoveIgnoresOf(itr->second);
         m_socialMap.erase(itr);
+    }
 }
 
 void SocialMgr::GetFriendInfo(Player *player, ObjectGuid::LowType friendGUID, FriendInfo &friendInfo)
@@ -307,6 +319,10 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid::LowT
     PlayerSocial* social = &m_socialMap[guid];
     social->SetPlayerGUID(guid);
 
+    // list may still be there if player logged in again before being unloaded
+    RemoveIgnoresOf(*social);
+    social->m_playerSocialMap.clear();
+
     if(!result)
         return social;
 
@@ -323,6 +339,8 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid::LowT
         note = fields[2].GetString();
 
         social->m_playerSocialMap[friend_guid] = FriendInfo(flags, note);
+        if (flags & SOCIAL_FLAG_IGNORED)
+            AddIgnoredBy(friend_guid);
 
         // client's friends list and ignore list limit
         if(social->m_playerSocialMap.size() >= (SOCIALMGR_FRIEND_LIMIT + SOCIALMGR_IGNORE_LIMIT))
@@ -333,3 +351,16 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid::LowT
     return social;
 }
 
+void SocialMgr::RemoveIgnoredBy(ObjectGuid::LowType guid)
+{
+    auto itr = m_ignoredByCount.find(guid);
+    if (itr != m_ignoredByCount.end() && --itr->second == 0)
+        m_ignoredByCount.erase(itr);
+}
+
+void SocialMgr::RemoveIgnoresOf(PlayerSocial const& social)
+{
+    for (auto const& itr : social.m_playerSocialMap)
+        if (itr.second.Flags & SOCIAL_FLAG_IGNORED)
+            RemoveIgnoredBy(itr.first);
+}
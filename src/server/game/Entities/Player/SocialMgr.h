@@ -135,8 +135,16 @@ class TC_GAME_API SocialMgr
         // Loading
         PlayerSocial* LoadFromDB(PreparedQueryResult result, ObjectGuid::LowType guid);
         PlayerSocial* GetDefault(ObjectGuid::LowType guid);
+        // Whether given player is in the ignore list of any loaded player, lets broadcasts skip ignore checks
+        bool IsIgnoredByAnyone(ObjectGuid::LowType guid) const { return m_ignoredByCount.find(guid) != m_ignoredByCount.end(); }
     private:
+        friend class PlayerSocial;
+        void AddIgnoredBy(ObjectGuid::LowType guid) { ++m_ignoredByCount[guid]; }
+        void RemoveIgnoredBy(ObjectGuid::LowType guid);
+        void RemoveIgnoresOf(PlayerSocial const& social);
+
         SocialMap m_socialMap;
+        std::unordered_map<ObjectGuid::LowType, uint32> m_ignoredByCount;  // number of loaded players ignoring each player
 };
 
 #define sSocialMgr SocialMgr::instance()
@@ -0,0 +1,146 @@
+#ifndef TRINITY_AURAEFFECTSLOTLIST_H
+#define TRINITY_AURAEFFECTSLOTLIST_H
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+class AuraEffect;
+
+/*
+Contiguous replacement for std::list<AuraEffect*>, used to store aura effects by type on units.
+
+Effects are kept in a vector so that scans (stat calculations, proc checks, ...) walk contiguous memory.
+It keeps the iterator guarantees of the list it replaces, code removing effects while iterating relies on them:
+- Removing an effect does not shift the others, its slot is just cleared (tombstone) and iterators skip it
+- Iterators store an index and not a pointer, so they stay valid when the storage grows
+- Effects added while iterating are visited, like with a list: end() is not a fixed index but always the current end of storage
+Cleared slots are only reclaimed with Compact(), which must be called when no iteration is running.
+*/
+class AuraEffectSlotList
+{
+public:
+    typedef AuraEffect* value_type;
+    typedef std::vector<AuraEffect*> Storage;
+
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef AuraEffect* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef AuraEffect* const* pointer;
+        typedef AuraEffect* reference;
+
+        const_iterator() : _list(nullptr), _index(0) { }
+        const_iterator(AuraEffectSlotList const* list, uint32 index) : _list(list), _index(index) { SkipRemoved(); }
+
+        AuraEffect* operator*() const { return _list->_slots[_index]; }
+        const_iterator& operator++() { ++_index; SkipRemoved(); return *this; }
+        const_iterator operator++(int) { const_iterator itr = *this; ++(*this); return itr; }
+        const_iterator& operator--()
+        {
+            _index = Position();
+            do
+                --_index;
+            while (_index > 0 && !_list->_slots[_index]);
+            return *this;
+        }
+        const_iterator operator--(int) { const_iterator itr = *this; --(*this); return itr; }
+
+        // end iterator is any index past the storage, compared against the current storage size so that slots added since are still reached
+        bool operator==(const_iterator const& right) const { return Position() == right.Position(); }
+        bool operator!=(const_iterator const& right) const { return Position() != right.Position(); }
+
+    private:
+        uint32 Position() const { return _list ? std::min(_index, uint32(_list->_slots.size())) : 0; }
+        void SkipRemoved()
+        {
+            while (_index < _list->_slots.size() && !_list->_slots[_index])
+                ++_index;
+        }
+
+        AuraEffectSlotList const* _list;
+        uint32 _index;
+    };
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+
+    AuraEffectSlotList() : _size(0) { }
+    // copies never hold removed slots
+    AuraEffectSlotList(AuraEffectSlotList const& right) : _size(right._size)
+    {
+        _slots.reserve(right._size);
+        for (AuraEffect* aurEff : right)
+            _slots.push_back(aurEff);
+    }
+    AuraEffectSlotList& operator=(AuraEffectSlotList const& right)
+    {
+        if (this != &right)
+        {
+            AuraEffectSlotList copy(right);
+            _slots.swap(copy._slots);
+            _size = copy._size;
+        }
+        return *this;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, END_INDEX); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    bool empty() const { return _size == 0; }
+    uint32 size() const { return _size; }
+    AuraEffect* front() const { return *begin(); }
+
+    void push_back(AuraEffect* aurEff)
+    {
+        _slots.push_back(aurEff);
+        ++_size;
+    }
+
+    // Clear the slot of given effect. Returns true if this is the first removed slot since last Compact()
+    bool remove(AuraEffect* aurEff)
+    {
+        Storage::iterator itr = std::find(_slots.begin(), _slots.end(), aurEff);
+        if (itr == _slots.end())
+            return false;
+
+        *itr = nullptr;
+        --_size;
+        if (itr + 1 == _slots.end() && _size + 1 == _slots.size())
+        {
+            // last slot and no other removed slot, nothing will need compacting
+            _slots.pop_back();
+            return false;
+        }
+        return _size + 1 == _slots.size();
+    }
+
+    void clear()
+    {
+        _slots.clear();
+        _size = 0;
+    }
+
+    // Reclaim removed slots. Invalidates iterators
+    void Compact()
+    {
+        if (_size != _slots.size())
+            _slots.erase(std::remove(_slots.begin(), _slots.end(), nullptr), _slots.end());
+    }
+
+private:
+    static uint32 const END_INDEX = std::numeric_limits<uint32>::max();
+
+    Storage _slots;
+    uint32 _size;
+};
+
+#endif
@@ -358,6 +358,7 @@ m_spellHistory(new SpellHistory(this))
 
     m_state = 0;
     m_deathState = ALIVE;
+    m_spatialIndexSlot = 0;
 
     for (auto & m_currentSpell : m_currentSpells)
         m_currentSpell = nullptr;
@@ -370,6 +371,7 @@ m_spellHistory(new SpellHistory(this))
     //tmpAura = NULL;
 
     m_auraUpdateIterator = m_ownedAuras.end();
+    m_procAurasNeedCompact = false;
 
     m_interruptMask = 0;
     m_transform = 0;
@@ -3485,6 +3487,20 @@ void Unit::_DeleteRemovedAuras()
     }
 
     m_removedAurasCount = 0;
+
+    // no aura effect list is being iterated here
+    for (AuraType type : m_modAurasToCompact)
+        m_modAuras[type].Compact();
+    m_modAurasToCompact.clear();
+
+    if (m_procAurasNeedCompact)
+    {
+        m_procAuras.erase(std::remove_if(m_procAuras.begin(), m_procAuras.end(), [](AuraApplicationProcCandidate const& candidate)
+        {
+            return !candidate.AurApp;
+        }), m_procAuras.end());
+        m_procAurasNeedCompact = false;
+    }
 }
 
 void Unit::_UpdateSpells(uint32 diff)
@@ -8819,6 +8835,7 @@ void Unit::AddToWorld()
     if(!IsInWorld())
     {
         WorldObject::AddToWorld();
+        GetMap()->GetUnitSpatialIndex().AddUnit(this);
     }
 }
 
@@ -8828,6 +8845,7 @@ void Unit::RemoveFromWorld()
     if(IsInWorld())
     {
         m_duringRemoveFromWorld = true;
+        GetMap()->GetUnitSpatialIndex().RemoveUnit(this);
 #ifdef LICH_KING
         if (IsVehicle())
             RemoveVehicleKit();
@@ -11421,6 +11439,9 @@ void Unit::NearTeleportTo(Position const& pos, bool casting /*= false*/)
     }
     else
     {
+        // queued spline would move unit back from its new position
+        if (IsInWorld())
+            GetMap()->DiscardMonsterMove(this);
         SendTeleportPacket(pos);
         UpdatePosition(pos, true);
         UpdateObjectVisibility();
@@ -12518,6 +12539,9 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
         m_interruptableAuras.push_back(aurApp);
         AddInterruptMask(aurSpellInfo->AuraInterruptFlags);
     }
+    // proc entries are only read here, auras applied before a spell_proc reload keep their old flags in the index
+    if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(aurId))
+        m_procAuras.push_back({ procEntry->ProcFlags, procEntry->SpellTypeMask, aurApp });
     if ((aura->GetSpellInfo()->Attributes & SPELL_ATTR0_HEARTBEAT_RESIST_CHECK)
         && !(aura->GetSpellInfo()->HasAuraEffect(SPELL_AURA_MOD_POSSESS))) //only dummy aura is breakable
     {
@@ -12614,6 +12638,16 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
         m_interruptableAuras.remove(aurApp);
         UpdateInterruptMask();
     }
+    // entries are cleared and not erased, the index may be iterated in GetProcAurasTriggeredOnEvent
+    for (AuraApplicationProcCandidate& candidate : m_procAuras)
+    {
+        if (candidate.AurApp == aurApp)
+        {
+            candidate.AurApp = nullptr;
+            m_procAurasNeedCompact = true;
+            break;
+        }
+    }
     if ((aura->GetSpellInfo()->Attributes & SPELL_ATTR0_HEARTBEAT_RESIST_CHECK)
         && !(aura->HasEffectType(SPELL_AURA_MOD_POSSESS))) //only dummy aura is breakable
     {
@@ -12740,8 +12774,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
     if (apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
-    else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    else if (m_modAuras[aurEff->GetAuraType()].remove(aurEff))
+        m_modAurasToCompact.push_back(aurEff->GetAuraType());
 }
 
 // All aura base removes should go through this function!
@@ -14301,12 +14335,23 @@ void Unit::GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTrigg
     // or generate one on our own
     else
     {
-        for (AuraApplicationMap::iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+        // only go through auras with a proc entry, and skip those that SpellMgr::CanSpellTriggerProcOnEvent would reject on flags alone
+        uint32 const typeMask = eventInfo.GetTypeMask();
+        bool const checkSpellTypeMask = (typeMask & SPELL_PROC_FLAG_MASK) && !(typeMask & (PROC_FLAG_KILLED | PROC_FLAG_KILL | PROC_FLAG_DEATH));
+        // index can grow while iterating (auras applied from scripts), do not keep references to it
+        for (size_t i = 0; i < m_procAuras.size(); ++i)
         {
-            if (uint8 procEffectMask = itr->second->GetBase()->GetProcEffectMask(itr->second, eventInfo, now))
+            AuraApplicationProcCandidate const candidate = m_procAuras[i];
+            if (!candidate.AurApp || !(candidate.ProcFlags & typeMask))
+                continue;
+
+            if (checkSpellTypeMask && candidate.SpellTypeMask && !(eventInfo.GetSpellTypeMask() & candidate.SpellTypeMask))
+                continue;
+
+            if (uint8 procEffectMask = candidate.AurApp->GetBase()->GetProcEffectMask(candidate.AurApp, eventInfo, now))
             {
-                itr->second->GetBase()->PrepareProcToTrigger(itr->second, eventInfo, now);
-                aurasTriggeringProc.emplace_back(procEffectMask, itr->second);
+                candidate.AurApp->GetBase()->PrepareProcToTrigger(candidate.AurApp, eventInfo, now);
+                aurasTriggeringProc.emplace_back(procEffectMask, candidate.AurApp);
             }
         }
     }
@@ -5,6 +5,7 @@
 #include "Object.h"
 #include "Opcodes.h"
 #include "Mthread.h"
+#include "AuraEffectSlotList.h"
 #include "SpellAuraDefines.h"
 #include "UpdateFields.h"
 #include "SharedDefines.h"
@@ -1207,12 +1208,21 @@ class TC_GAME_API Unit : public WorldObject
         typedef std::multimap<AuraStateType, AuraApplication*> AuraStateAurasMap;
         typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-        typedef std::list<AuraEffect*> AuraEffectList;
+        typedef AuraEffectSlotList AuraEffectList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<AuraApplication*> AuraApplicationList;
 
         typedef std::vector<std::pair<uint8 /*procEffectMask*/, AuraApplication*>> AuraApplicationProcContainer;
 
+        // applied aura able to proc, with the proc entry fields needed to discard it without looking the entry up
+        struct AuraApplicationProcCandidate
+        {
+            uint32 ProcFlags;
+            uint32 SpellTypeMask;
+            AuraApplication* AurApp; // null once removed, until the index is compacted
+        };
+        typedef std::vector<AuraApplicationProcCandidate> AuraApplicationProcIndex;
+
         typedef std::map<uint8, AuraApplication*> VisibleAuraMap;
 
         typedef std::list<DiminishingReturn> Diminishing;
@@ -2315,8 +2325,11 @@ class TC_GAME_API Unit : public WorldObject
         uint32 m_removedAurasCount; //count how much auras were removed (does not reset at each update)
 
         AuraEffectList m_modAuras[TOTAL_AURAS]; //all aura effects applied on this unit
+        std::vector<AuraType> m_modAurasToCompact; //m_modAuras lists with removed slots, compacted at next safe point
         AuraList m_scAuras;                     // casted singlecast auras. List auras casted on other units with the flag SPELL_ATTR5_SINGLE_TARGET_SPELL, such as polymorph
         AuraApplicationList m_interruptableAuras;          // auras on this unit with an AuraInterruptFlags
+        AuraApplicationProcIndex m_procAuras;               // auras on this unit with a spell proc entry, in apply order
+        bool m_procAurasNeedCompact;
         AuraApplicationList m_ccAuras; //crowd control aura with a chance of being interrupted by damage
         AuraStateAurasMap m_auraStateAuras;        // List of all auras affecting aura states, casted by who, Used for improve performance of aura state checks on aura apply/remove
         uint32 m_interruptMask;
@@ -2369,6 +2382,8 @@ class TC_GAME_API Unit : public WorldObject
         CombatManager m_combatManager; 
         friend class ThreatManager;
         ThreatManager m_threatManager;
+        friend class UnitSpatialIndex;
+        uint32 m_spatialIndexSlot;                          // slot in our map UnitSpatialIndex, only meaningful while the index is built
 
         std::unordered_set<AbstractFollower*> m_followingMe;
 
@@ -30,25 +30,40 @@ template<class T>
 void HashMapHolder<T>::Insert(T* o)
 {
     boost::unique_lock<boost::shared_mutex> lock(*GetLock());
-
     GetContainer()[o->GetGUID()] = o;
+
+    Shard& shard = GetShard(o->GetGUID());
+    boost::unique_lock<boost::shared_mutex> shardLock(shard.Lock);
+    shard.Objects[o->GetGUID()] = o;
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
     boost::unique_lock<boost::shared_mutex> lock(*GetLock());
-
     GetContainer().erase(o->GetGUID());
+
+    Shard& shard = GetShard(o->GetGUID());
+    boost::unique_lock<boost::shared_mutex> shardLock(shard.Lock);
+    shard.Objects.erase(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    boost::shared_lock<boost::shared_mutex> lock(*GetLock());
+    Shard& shard = GetShard(guid);
+    boost::shared_lock<boost::shared_mutex> lock(shard.Lock);
 
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : NULL;
+    auto itr = shard.Objects.find(guid);
+    return (itr != shard.Objects.end()) ? itr->second : nullptr;
+}
+
+template<class T>
+auto HashMapHolder<T>::GetShard(ObjectGuid guid) -> Shard&
+{
+    // counters are allocated sequentially, spreading them evenly over shards
+    static Shard _shards[SHARD_COUNT];
+    return _shards[guid.GetCounter() % SHARD_COUNT];
 }
 
 template<class T>
@@ -22,13 +22,27 @@ class DynamicObject;
 class WorldObject;
 class Map;
 
-/** Static hash map */
+/** Static hash map
+Lookups by guid only lock the shard owning the guid, map threads looking up different players thus do not contend on a single lock.
+The whole container is still kept for iteration, guarded by GetLock(). Writers lock GetLock() then the shard, in that order.
+*/
 template <class T>
 class TC_GAME_API HashMapHolder
 {
     //Non instanceable only static
     HashMapHolder() { }
 
+    static uint32 const SHARD_COUNT = 16;
+
+    // one cache line per shard, so that readers of different shards do not share the lock state
+    struct alignas(64) Shard
+    {
+        boost::shared_mutex Lock;
+        std::unordered_map<ObjectGuid, T*> Objects;
+    };
+
+    static Shard& GetShard(ObjectGuid guid);
+
 public:
 	static_assert(std::is_same<Player, T>::value
 		|| std::is_same<MotionTransport, T>::value,
@@ -42,6 +56,7 @@ public:
 
 	static T* Find(ObjectGuid guid);
 
+    // whole container, callers must hold GetLock()
     static MapType& GetContainer();
 
     static boost::shared_mutex* GetLock();
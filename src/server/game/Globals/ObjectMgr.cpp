@@ -3,6 +3,7 @@
 #include "Database/DatabaseEnv.h"
 
 #include "Log.h"
+#include "SpawnSnapshot.h"
 #include "CreatureAIFactory.h"
 #include "GameObjectAIFactory.h"
 #include "MapManager.h"
@@ -333,18 +334,19 @@ void ObjectMgr::RemoveArenaTeam(uint32 Id)
 
 CreatureTemplate const* ObjectMgr::GetCreatureTemplate(uint32 entry)
 {
-    return Trinity::Containers::MapGetValuePtr(_creatureTemplateStore, entry);
+    return _creatureTemplateIndex.Find(_creatureTemplateStore, entry);
 }
 
 GameObjectTemplate const* ObjectMgr::GetGameObjectTemplate(uint32 entry)
 {
-    return Trinity::Containers::MapGetValuePtr(_gameObjectTemplateStore, entry);
+    return _gameObjectTemplateIndex.Find(_gameObjectTemplateStore, entry);
 }
 
 void ObjectMgr::LoadCreatureLocales()
 {
     uint32 oldMSTime = GetMSTime();
 
+    _creatureLocaleIndex.Clear();
     _creatureLocaleStore.clear();                              // need for reload case
 //                                                    0        1                     3                      5                      7                      9                       11                    13                      15                
     QueryResult result = WorldDatabase.Query("SELECT entry,name_loc1,subname_loc1,name_loc2,subname_loc2,name_loc3,subname_loc3,name_loc4,subname_loc4,name_loc5,subname_loc5,name_loc6,subname_loc6,name_loc7,subname_loc7,name_loc8,subname_loc8 FROM locales_creature");
@@ -371,6 +373,8 @@ void ObjectMgr::LoadCreatureLocales()
         }
     } while (result->NextRow());
 
+    _creatureLocaleIndex.Build(_creatureLocaleStore);
+
     TC_LOG_INFO("server.loading", ">> Loaded %u creature locale strings in %u ms", uint32(_creatureLocaleStore.size()), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -454,6 +458,8 @@ void ObjectMgr::LoadCreatureTemplates(bool reload /* = false */)
     }
     while (result->NextRow());
 
+    _creatureTemplateIndex.Build(_creatureTemplateStore);
+
     // Checking needs to be done after loading because of the difficulty self referencing
     for (CreatureTemplateContainer::const_iterator itr = _creatureTemplateStore.begin(); itr != _creatureTemplateStore.end(); ++itr)
         CheckCreatureTemplate(&itr->second);
@@ -1045,7 +1051,7 @@ void ObjectMgr::LoadEquipmentTemplates()
 
 ItemTemplate const* ObjectMgr::GetItemTemplate(uint32 entry)
 {
-    return Trinity::Containers::MapGetValuePtr(_itemTemplateStore, entry);
+    return _itemTemplateIndex.Find(_itemTemplateStore, entry);
 }
 
 void ObjectMgr::LoadCreatureMovementOverrides()
@@ -1470,6 +1476,13 @@ bool ObjectMgr::SetCreatureLinkedRespawn(ObjectGuid::LowType spawnId, ObjectGuid
 
 void ObjectMgr::LoadCreatures()
 {
+    if (_spawnSnapshot && _spawnSnapshot->IsLoaded())
+    {
+        LoadCreaturesFromSnapshot(_spawnSnapshot->GetSpawns(SPAWN_TYPE_CREATURE));
+        return;
+    }
+
+    ByteBuffer* snapshot = _spawnSnapshot ? &_spawnSnapshot->GetSpawns(SPAWN_TYPE_CREATURE) : nullptr;
     uint32 count = 0;
     //                                                0              1   2    3
     QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid,"
@@ -1599,18 +1612,72 @@ void ObjectMgr::LoadCreatures()
         }
 
         // Add to grid if not managed by the game event or pool system
-        if (gameEvent == 0 && PoolId == 0)
+        bool addToGrid = gameEvent == 0 && PoolId == 0;
+        if (addToGrid)
             AddCreatureToGrid(guid, &data);
 
+        if (snapshot)
+        {
+            *snapshot << uint32(guid) << uint32(data.id) << uint32(data.spawnPoint.GetMapId());
+            *snapshot << data.spawnPoint.GetPositionX() << data.spawnPoint.GetPositionY() << data.spawnPoint.GetPositionZ() << data.spawnPoint.GetOrientation();
+            *snapshot << uint32(data.displayid) << int8(data.equipmentId) << int32(data.spawntimesecs) << float(data.spawndist);
+            *snapshot << uint32(data.currentwaypoint) << uint32(data.curhealth) << uint32(data.curmana) << uint8(data.movementType);
+            *snapshot << uint8(data.spawnMask) << uint32(data.poolId) << uint32(data.instanceEventId) << fields[19].GetString();
+            *snapshot << uint32(data.spawnGroupData->groupId) << uint8(addToGrid);
+        }
+
         ++count;
 
     } while (result->NextRow());
 
+    _creatureDataIndex.Build(_creatureDataStore);
     DeleteCreatureData(0);
 
     TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " creatures", _creatureDataStore.size());
 }
 
+void ObjectMgr::LoadCreaturesFromSnapshot(ByteBuffer& spawns)
+{
+    // spawns were checked when the snapshot was built
+    while (spawns.rpos() < spawns.size())
+    {
+        ObjectGuid::LowType guid = spawns.read<uint32>();
+        CreatureData& data = _creatureDataStore[guid];
+        data.id = spawns.read<uint32>();
+
+        uint32 mapId = spawns.read<uint32>();
+        float x = spawns.read<float>();
+        float y = spawns.read<float>();
+        float z = spawns.read<float>();
+        float o = spawns.read<float>();
+        data.spawnPoint.WorldRelocate(mapId, x, y, z, o);
+
+        data.displayid       = spawns.read<uint32>();
+        data.equipmentId     = spawns.read<int8>();
+        data.spawntimesecs   = spawns.read<int32>();
+        data.spawndist       = spawns.read<float>();
+        data.currentwaypoint = spawns.read<uint32>();
+        data.curhealth       = spawns.read<uint32>();
+        data.curmana         = spawns.read<uint32>();
+        data.movementType    = spawns.read<uint8>();
+        data.spawnMask       = spawns.read<uint8>();
+        data.poolId          = spawns.read<uint32>();
+        data.instanceEventId = spawns.read<uint32>();
+
+        std::string scriptName;
+        spawns >> scriptName;
+        data.scriptId = GetScriptId(scriptName);
+        data.spawnGroupData = &_spawnGroupDataStore[spawns.read<uint32>()];
+
+        if (spawns.read<uint8>())
+            AddCreatureToGrid(guid, &data);
+    }
+
+    _creatureDataIndex.Build(_creatureDataStore);
+
+    TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " creatures from spawn snapshot", _creatureDataStore.size());
+}
+
 void ObjectMgr::DeleteCreatureData(ObjectGuid::LowType guid)
 {
     // remove mapid*cellid -> guid_set map
@@ -1621,6 +1688,7 @@ void ObjectMgr::DeleteCreatureData(ObjectGuid::LowType guid)
         OnDeleteSpawnData(data);
     }
 
+    _creatureDataIndex.Remove(guid);
     _creatureDataStore.erase(guid);
 }
 
@@ -1658,6 +1726,13 @@ void ObjectMgr::RemoveCreatureFromGrid(ObjectGuid::LowType guid, CreatureData co
 
 void ObjectMgr::LoadGameObjects()
 {
+    if (_spawnSnapshot && _spawnSnapshot->IsLoaded())
+    {
+        LoadGameObjectsFromSnapshot(_spawnSnapshot->GetSpawns(SPAWN_TYPE_GAMEOBJECT));
+        return;
+    }
+
+    ByteBuffer* snapshot = _spawnSnapshot ? &_spawnSnapshot->GetSpawns(SPAWN_TYPE_GAMEOBJECT) : nullptr;
     uint32 count = 0;
 
     //                                                0                1   2    3           4           5           6
@@ -1726,7 +1801,7 @@ void ObjectMgr::LoadGameObjects()
         data.ArtKit         = 0;
         data.spawnMask      = fields[14].GetUInt8();
         int16 gameEvent     = fields[15].GetInt16();
-        data.ScriptId = GetScriptId(fields[16].GetString());
+        data.scriptId = GetScriptId(fields[16].GetString());
         //sun: use legacy group by default for instances, else it would break a lot of existing scripts. This will be overriden by any entry in spawn_group table.
         if (mapEntry->Instanceable())
             data.spawnGroupData = &_spawnGroupDataStore[1]; //Legacy group
@@ -1783,16 +1858,83 @@ void ObjectMgr::LoadGameObjects()
         }
 #endif
 
-        if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
+        bool addToGrid = gameEvent == 0 && PoolId == 0;         // if not this is to be managed by GameEvent System or Pool system
+        if (addToGrid)
             AddGameobjectToGrid(guid, &data);
 
+        if (snapshot)
+        {
+            *snapshot << uint32(guid) << uint32(data.id) << uint32(data.spawnPoint.GetMapId());
+            *snapshot << data.spawnPoint.GetPositionX() << data.spawnPoint.GetPositionY() << data.spawnPoint.GetPositionZ() << data.spawnPoint.GetOrientation();
+            *snapshot << data.rotation.x << data.rotation.y << data.rotation.z << data.rotation.w;
+            *snapshot << int32(data.spawntimesecs) << uint32(data.animprogress) << uint32(data.go_state) << uint8(data.spawnMask);
+            *snapshot << fields[16].GetString() << uint32(data.spawnGroupData->groupId) << uint8(addToGrid);
+        }
+
         ++count;
 
     } while (result->NextRow());
 
+    _gameObjectDataIndex.Build(_gameObjectDataStore);
+
     TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " gameobjects", _gameObjectDataStore.size());
 }
 
+void ObjectMgr::LoadGameObjectsFromSnapshot(ByteBuffer& spawns)
+{
+    // spawns were checked when the snapshot was built
+    while (spawns.rpos() < spawns.size())
+    {
+        ObjectGuid::LowType guid = spawns.read<uint32>();
+        GameObjectData& data = _gameObjectDataStore[guid];
+        data.id = spawns.read<uint32>();
+
+        uint32 mapId = spawns.read<uint32>();
+        float x = spawns.read<float>();
+        float y = spawns.read<float>();
+        float z = spawns.read<float>();
+        float o = spawns.read<float>();
+        data.spawnPoint.WorldRelocate(mapId, x, y, z, o);
+
+        data.rotation.x    = spawns.read<float>();
+        data.rotation.y    = spawns.read<float>();
+        data.rotation.z    = spawns.read<float>();
+        data.rotation.w    = spawns.read<float>();
+        data.spawntimesecs = spawns.read<int32>();
+        data.animprogress  = spawns.read<uint32>();
+        data.go_state      = spawns.read<uint32>();
+        data.ArtKit        = 0;
+        data.spawnMask     = spawns.read<uint8>();
+
+        std::string scriptName;
+        spawns >> scriptName;
+        data.scriptId = GetScriptId(scriptName);
+        data.spawnGroupData = &_spawnGroupDataStore[spawns.read<uint32>()];
+
+        if (spawns.read<uint8>())
+            AddGameobjectToGrid(guid, &data);
+    }
+
+    _gameObjectDataIndex.Build(_gameObjectDataStore);
+
+    TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " gameobjects from spawn snapshot", _gameObjectDataStore.size());
+}
+
+void ObjectMgr::OpenSpawnSnapshot(std::string const& path)
+{
+    _spawnSnapshot = std::make_unique<SpawnSnapshot>(path);
+    if (!_spawnSnapshot->Load())
+        TC_LOG_INFO("server.loading", "Spawn snapshot %s not found or outdated, spawns will be loaded from the world database", path.c_str());
+}
+
+void ObjectMgr::CloseSpawnSnapshot()
+{
+    if (_spawnSnapshot && !_spawnSnapshot->IsLoaded())
+        _spawnSnapshot->Save();
+
+    _spawnSnapshot.reset();
+}
+
 void ObjectMgr::LoadSpawnGroupTemplates()
 {
     uint32 oldMSTime = GetMSTime();
@@ -2127,6 +2269,7 @@ ObjectGuid::LowType ObjectMgr::AddCreatureData(uint32 entry, uint32 mapId, float
 
 void ObjectMgr::LoadItemLocales()
 {
+    _itemLocaleIndex.Clear();
     _itemLocaleStore.clear();                                 // need for reload case
 
     QueryResult result = WorldDatabase.Query("SELECT entry,name_loc1,description_loc1,name_loc2,description_loc2,name_loc3,description_loc3,name_loc4,description_loc4,name_loc5,description_loc5,name_loc6,description_loc6,name_loc7,description_loc7,name_loc8,description_loc8 FROM locales_item");
@@ -2152,6 +2295,8 @@ void ObjectMgr::LoadItemLocales()
         }
     } while (result->NextRow());
 
+    _itemLocaleIndex.Build(_itemLocaleStore);
+
     TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " Item locale strings", _itemLocaleStore.size());
 }
 void ObjectMgr::LoadItemTemplates()
@@ -2720,6 +2865,8 @@ void ObjectMgr::LoadItemTemplates()
         }*/
     } while (result->NextRow());
 
+    _itemTemplateIndex.Build(_itemTemplateStore);
+
     // Check if item templates for DBC referenced character start outfit are present
     std::set<uint32> notFoundOutfit;
     for (uint32 i = 1; i < sCharStartOutfitStore.GetNumRows(); ++i)
@@ -3535,6 +3682,7 @@ void ObjectMgr::LoadArenaTeams()
 void ObjectMgr::LoadQuests()
 {
     // For reload case
+    _questTemplateIndex.Clear();
     _questTemplates.clear();
 
     mExclusiveQuestGroups.clear();
@@ -3579,6 +3727,8 @@ void ObjectMgr::LoadQuests()
         _questTemplates.emplace(std::piecewise_construct, std::forward_as_tuple(questId), std::forward_as_tuple(fields));
     } while( result->NextRow() );
 
+    _questTemplateIndex.Build(_questTemplates);
+
     std::unordered_map<uint32, uint32> usedMailTemplates;
 
     struct QuestLoaderHelper
@@ -4262,6 +4412,7 @@ void ObjectMgr::LoadQuests()
 
 void ObjectMgr::LoadQuestLocales()
 {
+    _questLocaleIndex.Clear();
     _questLocaleStore.clear();                                // need for reload case
 
     QueryResult result = WorldDatabase.Query("SELECT entry,"
@@ -4306,6 +4457,8 @@ void ObjectMgr::LoadQuestLocales()
         }
     } while (result->NextRow());
 
+    _questLocaleIndex.Build(_questLocaleStore);
+
     TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " Quest locale strings", _questLocaleStore.size() );
 }
 
@@ -5702,7 +5855,7 @@ uint32 ObjectMgr::GetTaxiMountDisplayId(uint32 id, uint32 team, bool allowed_alt
 
 Quest const* ObjectMgr::GetQuestTemplate(uint32 quest_id) const
 {
-    return Trinity::Containers::MapGetValuePtr(_questTemplates, quest_id);
+    return _questTemplateIndex.Find(_questTemplates, quest_id);
 }
 
 void ObjectMgr::LoadGraveyardZones()
@@ -6361,6 +6514,7 @@ std::string ObjectMgr::GetItemText(uint32 id)
 
 void ObjectMgr::LoadGameObjectLocales()
 {
+    _gameObjectLocaleIndex.Clear();
     _gameObjectLocaleStore.clear();                           // need for reload case
 
     QueryResult result = WorldDatabase.Query("SELECT entry,"
@@ -6389,6 +6543,8 @@ void ObjectMgr::LoadGameObjectLocales()
         }
     } while (result->NextRow());
 
+    _gameObjectLocaleIndex.Build(_gameObjectLocaleStore);
+
     TC_LOG_INFO("server.loading", ">> Loaded " UI64FMTD " gameobject locale strings", _gameObjectLocaleStore.size());
     
 }
@@ -6606,6 +6762,8 @@ void ObjectMgr::LoadGameObjectTemplate()
     }
     while (result->NextRow());
 
+    _gameObjectTemplateIndex.Build(_gameObjectTemplateStore);
+
     TC_LOG_INFO("server.loading", ">> Loaded %u game object templates in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -6920,6 +7078,7 @@ void ObjectMgr::DeleteGameObjectData(ObjectGuid::LowType guid)
         OnDeleteSpawnData(data);
     }
 
+    _gameObjectDataIndex.Remove(guid);
     _gameObjectDataStore.erase(guid);
 }
 
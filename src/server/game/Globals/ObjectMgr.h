@@ -26,6 +26,7 @@ class ArenaTeam;
 class Item;
 enum PetNameInvalidReason : int;
 class Player;
+class SpawnSnapshot;
 struct PlayerClassInfo;
 struct PlayerClassLevelInfo;
 struct PlayerInfo;
@@ -328,6 +329,66 @@ struct QuestGreetingLocale
     std::vector<std::string> greeting;
 };
 
+/*
+Dense index over a store keyed by entry, lookups of indexed entries are an array access instead of a hash probe (like SpellMgr spell infos).
+The store keeps owning the values and must be node based, so that indexed pointers stay valid.
+Rebuild the index after loading the store, or Add/Remove values one by one for stores modified at runtime.
+Entries above maxDenseEntry (custom ones) and entries added since last build are still found in the store.
+*/
+template<class T>
+class DenseEntryIndex
+{
+public:
+    explicit DenseEntryIndex(uint32 maxDenseEntry = 0x100000) : _maxDenseEntry(maxDenseEntry) { }
+
+    template<class Container>
+    void Build(Container const& store)
+    {
+        uint32 size = 0;
+        for (auto const& pair : store)
+            if (pair.first < _maxDenseEntry)
+                size = std::max(size, pair.first + 1);
+
+        std::vector<T const*>(size, nullptr).swap(_entries);
+        for (auto const& pair : store)
+            if (pair.first < size)
+                _entries[pair.first] = &pair.second;
+    }
+
+    // must be called before erasing values from the store
+    void Clear() { std::vector<T const*>().swap(_entries); }
+
+    void Add(uint32 entry, T const* value)
+    {
+        if (entry >= _maxDenseEntry)
+            return;
+
+        if (entry >= _entries.size())
+            _entries.resize(entry + 1, nullptr);
+        _entries[entry] = value;
+    }
+
+    // must be called before erasing the value from the store
+    void Remove(uint32 entry)
+    {
+        if (entry < _entries.size())
+            _entries[entry] = nullptr;
+    }
+
+    template<class Container>
+    T const* Find(Container const& store, uint32 entry) const
+    {
+        if (entry < _entries.size() && _entries[entry])
+            return _entries[entry];
+
+        return Trinity::Containers::MapGetValuePtr(store, entry);
+    }
+
+private:
+    uint32 _maxDenseEntry;
+    std::vector<T const*> _entries;
+};
+
 typedef std::map<ObjectGuid, ObjectGuid> LinkedRespawnContainer;
 typedef std::unordered_map<uint32,CreatureData> CreatureDataContainer;
 typedef std::unordered_map<uint32,GameObjectData> GameObjectDataContainer;
@@ -773,6 +834,10 @@ class TC_GAME_API ObjectMgr
         void LoadCreatureModelInfo();
         void LoadEquipmentTemplates();
         void LoadCreatureMovementOverrides();
+        // Restore spawns from given snapshot in LoadCreatures and LoadGameObjects if it is up to date with the world database, else build it
+        void OpenSpawnSnapshot(std::string const& path);
+        // Save snapshot if spawns were loaded from the database, and release it
+        void CloseSpawnSnapshot();
 
         void LoadGameObjectLocales();
         void LoadGameObjects();
@@ -917,9 +982,14 @@ class TC_GAME_API ObjectMgr
         CreatureDataContainer const& GetAllCreatureData() const { return _creatureDataStore; }
         CreatureData const* GetCreatureData(ObjectGuid::LowType guid) const
         {
-            return Trinity::Containers::MapGetValuePtr(_creatureDataStore, guid);
+            return _creatureDataIndex.Find(_creatureDataStore, guid);
+        }
+        CreatureData& NewOrExistCreatureData(ObjectGuid::LowType guid)
+        {
+            CreatureData& data = _creatureDataStore[guid];
+            _creatureDataIndex.Add(guid, &data);
+            return data;
         }
-        CreatureData& NewOrExistCreatureData(ObjectGuid::LowType guid) { return _creatureDataStore[guid]; }
         void DeleteCreatureData(ObjectGuid::LowType guid);
         ObjectGuid GetLinkedRespawnGuid(ObjectGuid guid) const
         {
@@ -929,19 +999,19 @@ class TC_GAME_API ObjectMgr
         }
         CreatureLocale const* GetCreatureLocale(uint32 entry) const
         {
-            return Trinity::Containers::MapGetValuePtr(_creatureLocaleStore, entry);
+            return _creatureLocaleIndex.Find(_creatureLocaleStore, entry);
         }
         GameObjectLocale const* GetGameObjectLocale(uint32 entry) const
         {
-            return Trinity::Containers::MapGetValuePtr(_gameObjectLocaleStore, entry);
+            return _gameObjectLocaleIndex.Find(_gameObjectLocaleStore, entry);
         }
         ItemLocale const* GetItemLocale(uint32 entry) const
         {
-            return Trinity::Containers::MapGetValuePtr(_itemLocaleStore, entry);
+            return _itemLocaleIndex.Find(_itemLocaleStore, entry);
         }
         QuestLocale const* GetQuestLocale(uint32 entry) const
         {
-            return Trinity::Containers::MapGetValuePtr(_questLocaleStore, entry);
+            return _questLocaleIndex.Find(_questLocaleStore, entry);
         }
         NpcTextLocale const* GetNpcTextLocale(uint32 entry) const
         {
@@ -962,7 +1032,7 @@ class TC_GAME_API ObjectMgr
 
         GameObjectData const* GetGameObjectData(ObjectGuid::LowType guid) const
         {
-            return Trinity::Containers::MapGetValuePtr(_gameObjectDataStore, guid);
+            return _gameObjectDataIndex.Find(_gameObjectDataStore, guid);
         }
 
         GameObjectDataContainer const& GetGameObjectDataMap() const
@@ -970,7 +1040,12 @@ class TC_GAME_API ObjectMgr
             return _gameObjectDataStore;
         }
 
-        GameObjectData& NewOrExistGameObjectData(ObjectGuid::LowType guid) { return _gameObjectDataStore[guid]; }
+        GameObjectData& NewOrExistGameObjectData(ObjectGuid::LowType guid)
+        {
+            GameObjectData& data = _gameObjectDataStore[guid];
+            _gameObjectDataIndex.Add(guid, &data);
+            return data;
+        }
         void DeleteGameObjectData(ObjectGuid::LowType guid);
 
         QuestGreetingLocale const* GetQuestGreetingLocale(uint32 id) const
@@ -1157,6 +1232,7 @@ class TC_GAME_API ObjectMgr
 		std::map<HighGuid, std::unique_ptr<ObjectGuidGeneratorBase>> _guidGenerators;
 
         QuestContainer            _questTemplates;
+        DenseEntryIndex<Quest>    _questTemplateIndex;
 
         typedef std::unordered_map<uint32, GossipText*> GossipTextMap;
         typedef std::unordered_map<uint32, uint32> QuestAreaTriggerMap;
@@ -1216,13 +1292,18 @@ class TC_GAME_API ObjectMgr
         CreatureAddonContainer _creatureTemplateAddonStore;
         std::unordered_map<ObjectGuid::LowType, CreatureMovementData> _creatureMovementOverrides;
         GameObjectTemplateContainer _gameObjectTemplateStore;
+        DenseEntryIndex<GameObjectTemplate> _gameObjectTemplateIndex;
         CreatureTemplateContainer _creatureTemplateStore;
+        DenseEntryIndex<CreatureTemplate> _creatureTemplateIndex;
         ItemTemplateContainer _itemTemplateStore;
+        DenseEntryIndex<ItemTemplate> _itemTemplateIndex;
         BroadcastTextContainer _broadcastTextStore;
         SpellScriptsContainer _spellScriptsStore;
 
     private:
         void LoadScripts(ScriptMapMap& scripts, char const* tablename);
+        void LoadCreaturesFromSnapshot(ByteBuffer& spawns);
+        void LoadGameObjectsFromSnapshot(ByteBuffer& spawns);
         void ConvertCreatureAddonAuras(CreatureAddon* addon, char const* table, char const* guidEntryStr);
         void LoadQuestRelationsHelper(QuestRelations& map,char const* table);
 
@@ -1246,13 +1327,20 @@ class TC_GAME_API ObjectMgr
         HalfNameMap PetHalfName0;
         HalfNameMap PetHalfName1;
 
+        std::unique_ptr<SpawnSnapshot> _spawnSnapshot;
         MapObjectGuids _mapObjectGuidsStore;
         CreatureDataContainer _creatureDataStore;
+        DenseEntryIndex<CreatureData> _creatureDataIndex;
         CreatureLocaleContainer _creatureLocaleStore;
+        DenseEntryIndex<CreatureLocale> _creatureLocaleIndex;
         GameObjectDataContainer _gameObjectDataStore;
+        DenseEntryIndex<GameObjectData> _gameObjectDataIndex;
         GameObjectLocaleContainer _gameObjectLocaleStore;
+        DenseEntryIndex<GameObjectLocale> _gameObjectLocaleIndex;
         ItemLocaleContainer _itemLocaleStore;
+        DenseEntryIndex<ItemLocale> _itemLocaleIndex;
         QuestLocaleContainer _questLocaleStore;
+        DenseEntryIndex<QuestLocale> _questLocaleIndex;
         NpcTextLocaleContainer mGossipTextLocaleMap;
         PageTextLocaleContainer mPageTextLocaleMap;
         TrinityStringLocaleContainer _trinityStringStore;
@@ -0,0 +1,170 @@
+#include "SpawnSnapshot.h"
+#include "DatabaseEnv.h"
+#include "DBCStores.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "Timer.h"
+#include <boost/filesystem/operations.hpp>
+
+namespace
+{
+    uint32 const SPAWN_SNAPSHOT_VERSION = 1;
+
+    // every table ObjectMgr::LoadCreatures and ObjectMgr::LoadGameObjects read from or check spawns against
+    char const* const SPAWN_SNAPSHOT_TABLES[] = { "creature", "creature_encounter_respawn", "creature_equip_template", "creature_template", "game_event_creature",
+        "game_event_gameobject", "gameobject", "gameobject_template", "pool_creature", "pool_gameobject" };
+
+    /*
+    Snapshot file:
+    - uint32 version
+    - revision, SHA1 of the core revision, dbc files stamp and world tables checksums
+    - digest, SHA1 of the rest of the file
+    - for each spawn type: uint32 size, spawns written by ObjectMgr
+    */
+    size_t const SPAWN_SNAPSHOT_HEADER_SIZE = sizeof(uint32) + 2 * SHA_DIGEST_LENGTH;
+}
+
+SpawnSnapshot::SpawnSnapshot(std::string const& path) : _path(path), _revision(), _loaded(false)
+{
+}
+
+bool SpawnSnapshot::GetTablesChecksums(std::string& marker)
+{
+    std::string names;
+    for (char const* table : SPAWN_SNAPSHOT_TABLES)
+        names += Trinity::StringFormat("%s%s", names.empty() ? "" : ", ", table);
+
+    QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE %s", names.c_str());
+    if (!result)
+        return false;
+
+    marker = "checksums;";
+    do
+    {
+        Field* fields = result->Fetch();
+        // checksum is null for missing tables
+        marker += Trinity::StringFormat("%s:%s;", fields[0].GetString().c_str(), fields[1].GetString().c_str());
+    } while (result->NextRow());
+
+    return true;
+}
+
+bool SpawnSnapshot::ComputeRevision()
+{
+    uint32 const oldMSTime = GetMSTime();
+
+    // information_schema update times are not reliable (InnoDB may serve them from a stats cache kept up to a day), CHECKSUM TABLE reads every row
+    std::string marker;
+    if (!GetTablesChecksums(marker))
+        return false;
+
+    SHA1Hash sha;
+    sha.UpdateData(GitRevision::GetHash());
+    // spawns are checked against dbc data
+    sha.UpdateData(GetDBCFilesStamp());
+    sha.UpdateData(marker);
+    sha.Finalize();
+
+    memcpy(_revision, sha.GetDigest(), SHA_DIGEST_LENGTH);
+    TC_LOG_INFO("server.loading", ">> Spawn snapshot revision computed from world tables checksums in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    return true;
+}
+
+bool SpawnSnapshot::Load()
+{
+    _loaded = false;
+    for (ByteBuffer& spawns : _spawns)
+        spawns.clear();
+
+    if (!ComputeRevision())
+        return false;
+
+    FILE* f = fopen(_path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    long fileSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    std::vector<uint8> file(fileSize > 0 ? size_t(fileSize) : 0);
+    bool read = !file.empty() && fread(file.data(), file.size(), 1, f) == 1;
+    fclose(f);
+    if (!read || file.size() < SPAWN_SNAPSHOT_HEADER_SIZE)
+        return false;
+
+    uint32 version;
+    memcpy(&version, file.data(), sizeof(version));
+    uint8 const* revision = file.data() + sizeof(version);
+    uint8 const* digest = revision + SHA_DIGEST_LENGTH;
+    if (version != SPAWN_SNAPSHOT_VERSION || memcmp(revision, _revision, SHA_DIGEST_LENGTH))
+        return false;
+
+    SHA1Hash sha;
+    sha.UpdateData(file.data() + SPAWN_SNAPSHOT_HEADER_SIZE, int(file.size() - SPAWN_SNAPSHOT_HEADER_SIZE));
+    sha.Finalize();
+    if (memcmp(digest, sha.GetDigest(), SHA_DIGEST_LENGTH))
+        return false;
+
+    size_t offset = SPAWN_SNAPSHOT_HEADER_SIZE;
+    for (ByteBuffer& spawns : _spawns)
+    {
+        uint32 size;
+        if (offset + sizeof(size) > file.size())
+            return false;
+
+        memcpy(&size, file.data() + offset, sizeof(size));
+        offset += sizeof(size);
+        if (offset + size > file.size())
+            return false;
+
+        spawns.append(file.data() + offset, size);
+        offset += size;
+    }
+
+    _loaded = offset == file.size();
+    return _loaded;
+}
+
+bool SpawnSnapshot::Save()
+{
+    ByteBuffer body;
+    for (ByteBuffer const& spawns : _spawns)
+    {
+        body << uint32(spawns.size());
+        if (spawns.size())
+            body.append(spawns.contents(), spawns.size());
+    }
+
+    SHA1Hash sha;
+    sha.UpdateData(body.contents(), int(body.size()));
+    sha.Finalize();
+
+    // written aside then renamed, so that a crash while writing leaves no truncated snapshot
+    std::string tmpPath = _path + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f)
+    {
+        TC_LOG_ERROR("server.loading", "SpawnSnapshot: Could not create %s", tmpPath.c_str());
+        return false;
+    }
+
+    bool written = fwrite(&SPAWN_SNAPSHOT_VERSION, sizeof(SPAWN_SNAPSHOT_VERSION), 1, f) == 1
+        && fwrite(_revision, SHA_DIGEST_LENGTH, 1, f) == 1
+        && fwrite(sha.GetDigest(), SHA_DIGEST_LENGTH, 1, f) == 1
+        && fwrite(body.contents(), body.size(), 1, f) == 1;
+    written = fclose(f) == 0 && written;
+
+    boost::system::error_code error;
+    if (written)
+        boost::filesystem::rename(tmpPath, _path, error);
+
+    if (!written || error)
+    {
+        TC_LOG_ERROR("server.loading", "SpawnSnapshot: Could not write %s", _path.c_str());
+        boost::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    return true;
+}
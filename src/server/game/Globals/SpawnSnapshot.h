@@ -0,0 +1,44 @@
+#ifndef TRINITY_SPAWNSNAPSHOT_H
+#define TRINITY_SPAWNSNAPSHOT_H
+
+#include "Define.h"
+#include "ByteBuffer.h"
+#include "SpawnData.h"
+#include "SHA1.h"
+#include <string>
+
+/*
+Binary snapshot of the creature and gameobject spawns, as loaded by ObjectMgr from the world database.
+Spawns are the biggest world tables, restoring them from the snapshot at startup skips their queries and checks.
+
+The snapshot is keyed by a revision built from the core revision, the dbc files spawns are checked against and the tables spawns are loaded from.
+Tables are identified by CHECKSUM TABLE, which reads every row. Their information_schema update times can't be used: InnoDB on MySQL 8.0
+serves them from a stats cache that may be a day old.
+Any change to these tables or dbc files makes the spawns be loaded from the database again, and the snapshot rebuilt after it.
+ObjectMgr writes spawns to the snapshot after its checks, as they end up in its stores.
+*/
+class TC_GAME_API SpawnSnapshot
+{
+public:
+    explicit SpawnSnapshot(std::string const& path);
+
+    // Compute the world database revision and read the snapshot file if it was built from it
+    bool Load();
+    // Write spawns loaded from the database, when snapshot could not be loaded
+    bool Save();
+
+    bool IsLoaded() const { return _loaded; }
+    ByteBuffer& GetSpawns(SpawnObjectType type) { return _spawns[type]; }
+
+private:
+    bool ComputeRevision();
+    // Identify spawn tables content
+    static bool GetTablesChecksums(std::string& marker);
+
+    std::string _path;
+    uint8 _revision[SHA_DIGEST_LENGTH];
+    ByteBuffer _spawns[SPAWN_TYPE_MAX];
+    bool _loaded;
+};
+
+#endif
@@ -16,6 +16,30 @@ u_map_magic MapLiquidMagic  = { {'M','L','I','Q'} };
 static uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 static uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
+static uint32 const V8_POINT_COUNT = MAP_RESOLUTION * MAP_RESOLUTION;
+static uint32 const V9_POINT_COUNT = (MAP_RESOLUTION + 1) * (MAP_RESOLUTION + 1);
+static std::align_val_t const HEIGHT_DATA_ALIGNMENT = std::align_val_t(64);
+
+// Index of a V8 point, or of one of the first 128x128 V9 points, in 8x8 blocks
+static inline uint32 GetBlockedHeightIndex(uint32 x, uint32 y)
+{
+    return ((x >> 3) * (MAP_RESOLUTION / 8) + (y >> 3)) * 64 + ((x & 7) << 3) + (y & 7);
+}
+
+static inline uint32 GetV9HeightIndex(uint32 x, uint32 y)
+{
+    if (x < MAP_RESOLUTION && y < MAP_RESOLUTION)
+        return GetBlockedHeightIndex(x, y);
+    if (x == MAP_RESOLUTION)
+        return V8_POINT_COUNT + y;
+
+    return V8_POINT_COUNT + (MAP_RESOLUTION + 1) + x;
+}
+
+// Integer formats are interpolated as int32, then scaled
+template<class T> struct GridHeightValue { typedef int32 Type; };
+template<> struct GridHeightValue<float> { typedef float Type; };
+
 // *****************************
 // Grid function
 // *****************************
@@ -27,10 +51,9 @@ GridMap::GridMap()
     _areaMap = nullptr;
     // Height level data
     _gridHeight = INVALID_HEIGHT;
-    _gridGetHeight = &GridMap::getHeightFromFlat;
     _gridIntHeightMultiplier = 0;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
+    _heightData = nullptr;
+    _heightFormat = GRID_HEIGHT_FLAT;
     _maxHeight = nullptr;
     _minHeight = nullptr;
     // Liquid data
@@ -111,8 +134,8 @@ bool GridMap::loadData(char* filename)
 void GridMap::unloadData()
 {
     delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
+    if (_heightData)
+        ::operator delete[](_heightData, HEIGHT_DATA_ALIGNMENT);
     delete[] _liquidEntry;
     delete[] _liquidFlags;
     delete[] _liquidMap;
@@ -120,15 +143,14 @@ void GridMap::unloadData()
     delete[] _minHeight;
     delete[] _maxHeight;
     _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
+    _heightData = nullptr;
     _maxHeight = nullptr;
     _minHeight = nullptr;
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
     _holes = nullptr;
-    _gridGetHeight = &GridMap::getHeightFromFlat;
+    _heightFormat = GRID_HEIGHT_FLAT;
 }
 
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
@@ -162,37 +184,27 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!loadHeightPoints<uint16>(in))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
-            _gridGetHeight = &GridMap::getHeightFromUint16;
+            _heightFormat = GRID_HEIGHT_UINT16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!loadHeightPoints<uint8>(in))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
-            _gridGetHeight = &GridMap::getHeightFromUint8;
+            _heightFormat = GRID_HEIGHT_UINT8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            if (!loadHeightPoints<float>(in))
                 return false;
-            _gridGetHeight = &GridMap::getHeightFromFloat;
+            _heightFormat = GRID_HEIGHT_FLOAT;
         }
     }
     else
-        _gridGetHeight = &GridMap::getHeightFromFlat;
-
+        _heightFormat = GRID_HEIGHT_FLAT;
 
     if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
@@ -206,6 +218,31 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+template<class T>
+bool GridMap::loadHeightPoints(FILE* in)
+{
+    std::vector<T> v9(V9_POINT_COUNT);
+    std::vector<T> v8(V8_POINT_COUNT);
+    if (fread(v9.data(), sizeof(T), V9_POINT_COUNT, in) != V9_POINT_COUNT ||
+        fread(v8.data(), sizeof(T), V8_POINT_COUNT, in) != V8_POINT_COUNT)
+        return false;
+
+    // V8 first, so that blocks of both are aligned on cache lines
+    _heightData = static_cast<uint8*>(::operator new[]((V8_POINT_COUNT + V9_POINT_COUNT) * sizeof(T), HEIGHT_DATA_ALIGNMENT));
+    T* v8Blocks = reinterpret_cast<T*>(_heightData);
+    T* v9Blocks = v8Blocks + V8_POINT_COUNT;
+
+    for (uint32 x = 0; x < MAP_RESOLUTION; ++x)
+        for (uint32 y = 0; y < MAP_RESOLUTION; ++y)
+            v8Blocks[GetBlockedHeightIndex(x, y)] = v8[x * MAP_RESOLUTION + y];
+
+    for (uint32 x = 0; x <= MAP_RESOLUTION; ++x)
+        for (uint32 y = 0; y <= MAP_RESOLUTION; ++y)
+            v9Blocks[GetV9HeightIndex(x, y)] = v9[x * (MAP_RESOLUTION + 1) + y];
+
+    return true;
+}
+
 bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
@@ -264,16 +301,47 @@ uint16 GridMap::getArea(float x, float y) const
     return _areaMap[lx*16 + ly];
 }
 
-float GridMap::getHeightFromFlat(float /*x*/, float /*y*/, bool /*walkableOnly*/) const
+float GridMap::getHeight(float x, float y, bool /*walkableOnly*/) const
 {
-    return _gridHeight;
+    switch (_heightFormat)
+    {
+        case GRID_HEIGHT_FLOAT:
+            return getHeightFrom<float>(x, y);
+        case GRID_HEIGHT_UINT16:
+            return getHeightFrom<uint16>(x, y);
+        case GRID_HEIGHT_UINT8:
+            return getHeightFrom<uint8>(x, y);
+        default:
+            return _gridHeight;
+    }
 }
 
-float GridMap::getHeightFromFloat(float x, float y, bool walkableOnly) const
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
 {
-    if (!m_V8 || !m_V9)
-        return _gridHeight;
+    // format is checked once for all points
+    switch (_heightFormat)
+    {
+        case GRID_HEIGHT_FLOAT:
+            for (uint32 i = 0; i < count; ++i)
+                heights[i] = getHeightFrom<float>(x[i], y[i]);
+            break;
+        case GRID_HEIGHT_UINT16:
+            for (uint32 i = 0; i < count; ++i)
+                heights[i] = getHeightFrom<uint16>(x[i], y[i]);
+            break;
+        case GRID_HEIGHT_UINT8:
+            for (uint32 i = 0; i < count; ++i)
+                heights[i] = getHeightFrom<uint8>(x[i], y[i]);
+            break;
+        default:
+            std::fill(heights, heights + count, _gridHeight);
+            break;
+    }
+}
 
+template<class T>
+float GridMap::getHeightFrom(float x, float y) const
+{
     x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
     y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
 
@@ -301,196 +369,27 @@ float GridMap::getHeightFromFloat(float x, float y, bool walkableOnly) const
     // 1 - detect triangle
     // 2 - solve linear equation from triangle points
     // Calculate coefficients for solve h = a*x + b*y + c
+    typedef typename GridHeightValue<T>::Type Value;
+    T const* v8 = reinterpret_cast<T const*>(_heightData);
+    T const* v9 = v8 + V8_POINT_COUNT;
+
+    // all points are read and the triangle is selected without branches, it can't be predicted for nearby points
+    Value h1 = v9[GetV9HeightIndex(x_int, y_int)];
+    Value h2 = v9[GetV9HeightIndex(x_int + 1, y_int)];
+    Value h3 = v9[GetV9HeightIndex(x_int, y_int + 1)];
+    Value h4 = v9[GetV9HeightIndex(x_int + 1, y_int + 1)];
+    Value h5 = 2 * Value(v8[GetBlockedHeightIndex(x_int, y_int)]);
+
+    bool const top = x + y < 1;
+    bool const right = x > y;
+    // triangles: 1 (h1, h2, h5), 2 (h1, h3, h5), 3 (h2, h4, h5), 4 (h3, h4, h5)
+    Value a = top ? (right ? h2 - h1 : h5 - h1 - h3) : (right ? h2 + h4 - h5 : h4 - h3);
+    Value b = top ? (right ? h5 - h1 - h2 : h3 - h1) : (right ? h4 - h2 : h3 + h4 - h5);
+    Value c = top ? h1 : h5 - h4;
 
-    float a, b, c;
-    // Select triangle:
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            float h1 = m_V9[(x_int)*129 + y_int];
-            float h2 = m_V9[(x_int+1)*129 + y_int];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            float h1 = m_V9[x_int*129 + y_int  ];
-            float h3 = m_V9[x_int*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            float h2 = m_V9[(x_int+1)*129 + y_int  ];
-            float h4 = m_V9[(x_int+1)*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            float h3 = m_V9[(x_int)*129 + y_int+1];
-            float h4 = m_V9[(x_int+1)*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return a * x + b * y + c;
-}
-
-float GridMap::getHeightFromUint8(float x, float y, bool walkableOnly) const
-{
-    if (!m_uint8_V8 || !m_uint8_V9)
-        return _gridHeight;
-
-    x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int&=(MAP_RESOLUTION - 1);
-    y_int&=(MAP_RESOLUTION - 1);
-
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
-
-    int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
-}
-
-float GridMap::getHeightFromUint16(float x, float y, bool walkableOnly) const
-{
-    if (!m_uint16_V8 || !m_uint16_V9)
-        return _gridHeight;
-
-    x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int&=(MAP_RESOLUTION - 1);
-    y_int&=(MAP_RESOLUTION - 1);
-
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
-
-    int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // triangle 1 (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // triangle 2 (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // triangle 3 (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // triangle 4 (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
     // Calculate height
+    if (std::is_floating_point<T>::value)
+        return a * x + b * y + c;
 
     return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
 }
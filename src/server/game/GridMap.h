@@ -59,19 +59,25 @@ struct map_liquidHeader
     float  liquidLevel;
 };
 
+enum GridMapHeightFormat : uint8
+{
+    GRID_HEIGHT_FLAT,
+    GRID_HEIGHT_FLOAT,
+    GRID_HEIGHT_UINT16,
+    GRID_HEIGHT_UINT8,
+};
+
 class GridMap
 {
     uint32  _flags;
-    union{
-        float* m_V9;
-        uint16* m_uint16_V9;
-        uint8* m_uint8_V9;
-    };
-    union{
-        float* m_V8;
-        uint16* m_uint16_V8;
-        uint8* m_uint8_V8;
-    };
+
+    /*
+    V8 and V9 height points in a single buffer of _heightFormat values, V8 first so that blocks of both are aligned on cache lines.
+    Points are not stored row by row as in the .map file but in blocks of 8x8, the points used by a height query
+    then usually share a cache line instead of being spread over three rows. Last row and column of V9 are stored after its blocks.
+    */
+    uint8* _heightData;
+    GridMapHeightFormat _heightFormat;
     int16* _maxHeight;
     int16* _minHeight;
 
@@ -102,13 +108,10 @@ class GridMap
     bool loadHolesData(FILE* in, uint32 offset, uint32 size);
     bool isHole(int row, int col) const;
 
-    // Get height functions and pointers. walkableOnly NYI
-    typedef float (GridMap::*GetHeightPtr) (float x, float y, bool walkableOnly) const;
-    GetHeightPtr _gridGetHeight;
-    float getHeightFromFloat(float x, float y, bool walkableOnly = false) const;
-    float getHeightFromUint16(float x, float y, bool walkableOnly = false) const;
-    float getHeightFromUint8(float x, float y, bool walkableOnly = false) const;
-    float getHeightFromFlat(float x, float y, bool walkableOnly = false) const;
+    template<class T>
+    bool loadHeightPoints(FILE* in);
+    template<class T>
+    float getHeightFrom(float x, float y) const;
     
 public:
     GridMap();
@@ -117,7 +120,10 @@ public:
     void unloadData();
 
     uint16 getArea(float x, float y) const;
-    inline float getHeight(float x, float y, bool walkableOnly = false) const {return (this->*_gridGetHeight)(x, y, walkableOnly);}
+    // walkableOnly NYI
+    float getHeight(float x, float y, bool walkableOnly = false) const;
+    // heights of count points, same results as getHeight
+    void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     ZLiquidStatus GetLiquidStatus(float x, float y, float z, uint8 ReqLiquidTypeMask, LiquidData* data = nullptr, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
@@ -9,6 +9,8 @@
 #include "Transport.h"
 #include "ObjectAccessor.h"
 #include "CellImpl.h"
+#include "CreatureAI.h"
+#include "World.h"
 
 using namespace Trinity;
 
@@ -90,7 +92,10 @@ void VisibleChangesNotifier::Visit(DynamicObjectMapType &m)
                     player->UpdateVisibilityOf(&i_object);
 }
 
-inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
+// MoveInLineOfSight calls of a notifier visit, made once the line of sight of their aggro checks is resolved at once
+typedef std::vector<std::pair<Creature*, Unit*>> MoveInLineOfSightCalls;
+
+inline void CreatureUnitRelocationWorker(Creature* c, Unit* u, MoveInLineOfSightCalls& calls)
 {
     if (!u->IsAlive() || !c->IsAlive() || c == u || u->IsInFlight())
         return;
@@ -98,7 +103,7 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
     if (!c->HasUnitState(UNIT_STATE_SIGHTLESS))
     {
         if (c->IsAIEnabled && c->CanSeeOrDetect(u, false, true))
-            c->AI()->MoveInLineOfSight_Safe(u);
+            calls.emplace_back(c, u);
         else
             if (u->GetTypeId() == TYPEID_PLAYER && u->HasStealthAura() && c->IsAIEnabled && /* c->CanSeeOrDetect(u, false, true, true) already in next check */ c->CanDoStealthAlert(u))
                 //c->AI()->TriggerAlert(u);
@@ -106,6 +111,43 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
     }
 }
 
+static void DoMoveInLineOfSightCalls(MoveInLineOfSightCalls const& calls)
+{
+    if (calls.empty())
+        return;
+
+    // pairs passing every other aggro check get their line of sight in one query, results are stored in the map line of sight cache CanAggro reads
+    if (sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL))
+    {
+        Map* map = calls.front().first->GetMap();
+        uint32 const phaseMask = calls.front().first->GetPhaseMask();
+        std::vector<VMAP::LineOfSightSegment> segments;
+        for (auto const& call : calls)
+        {
+            Creature* c = call.first;
+            // same early returns as CreatureAI::MoveInLineOfSight
+            if (c->GetPhaseMask() != phaseMask || !c->HasReactState(REACT_AGGRESSIVE) || (c->GetVictim() && !c->IsWithinMeleeRange(call.second)))
+                continue;
+
+            if (c->CanAggro(call.second, false, false) == CAN_ATTACK_RESULT_OK)
+                segments.push_back(c->GetLineOfSightSegment(call.second));
+        }
+
+        if (segments.size() > 1)
+        {
+            std::vector<bool> results;
+            map->isInLineOfSightMulti(segments, phaseMask, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing, results);
+        }
+    }
+
+    for (auto const& call : calls)
+    {
+        // a previous call may have changed them
+        if (call.first->IsAIEnabled && call.first->IsAlive() && call.second->IsAlive())
+            call.first->AI()->MoveInLineOfSight_Safe(call.second);
+    }
+}
+
 void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -126,6 +168,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 void PlayerRelocationNotifier::Visit(CreatureMapType &m)
 {
     bool relocated_for_ai = (&i_player == i_player.m_seer);
+    MoveInLineOfSightCalls calls;
 
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
@@ -136,12 +179,15 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
         if (relocated_for_ai && !c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            CreatureUnitRelocationWorker(c, &i_player);
+            CreatureUnitRelocationWorker(c, &i_player, calls);
     }
+
+    DoMoveInLineOfSightCalls(calls);
 }
 
 void CreatureRelocationNotifier::Visit(PlayerMapType &m)
 {
+    MoveInLineOfSightCalls calls;
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Player* player = iter->GetSource();
@@ -149,8 +195,10 @@ void CreatureRelocationNotifier::Visit(PlayerMapType &m)
         if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             player->UpdateVisibilityOf(&i_creature);
 
-        CreatureUnitRelocationWorker(&i_creature, player);
+        CreatureUnitRelocationWorker(&i_creature, player, calls);
     }
+
+    DoMoveInLineOfSightCalls(calls);
 }
 
 void CreatureRelocationNotifier::Visit(CreatureMapType &m)
@@ -158,14 +206,17 @@ void CreatureRelocationNotifier::Visit(CreatureMapType &m)
     if (!i_creature.IsAlive())
         return;
 
+    MoveInLineOfSightCalls calls;
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->GetSource();
-        CreatureUnitRelocationWorker(&i_creature, c);
+        CreatureUnitRelocationWorker(&i_creature, c, calls);
 
         if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            CreatureUnitRelocationWorker(c, &i_creature);
+            CreatureUnitRelocationWorker(c, &i_creature, calls);
     }
+
+    DoMoveInLineOfSightCalls(calls);
 }
 
 void DelayedUnitRelocation::Visit(CreatureMapType &m)
@@ -216,13 +267,16 @@ void DelayedUnitRelocation::Visit(PlayerMapType &m)
 
 void AIRelocationNotifier::Visit(CreatureMapType &m)
 {
+    MoveInLineOfSightCalls calls;
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->GetSource();
-        CreatureUnitRelocationWorker(c, &i_unit);
+        CreatureUnitRelocationWorker(c, &i_unit, calls);
         if (isCreature)
-            CreatureUnitRelocationWorker((Creature*)&i_unit, c);
+            CreatureUnitRelocationWorker((Creature*)&i_unit, c, calls);
     }
+
+    DoMoveInLineOfSightCalls(calls);
 }
 
 
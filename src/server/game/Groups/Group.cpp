@@ -1812,13 +1812,13 @@ void Group::Update(time_t diff)
     }
 }
 
-void Group::UpdatePlayerOutOfRange(Player* player)
+void Group::UpdatePlayerOutOfRange(Player* player, bool onlyChangedValues)
 {
     if (!player || !player->IsInWorld())
         return;
 
     //sunstrider: Only build packet if needed
-    std::list<Player const*> sendTo;
+    std::vector<Player const*> sendTo;
     Player const* member;
     for (GroupReference *itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
@@ -1828,6 +1828,14 @@ void Group::UpdatePlayerOutOfRange(Player* player)
     }
 
     if (sendTo.empty())
+    {
+        player->ResetGroupUpdateSentValues();
+        return;
+    }
+
+    if (!onlyChangedValues)
+        player->ResetGroupUpdateSentValues();
+    else if (!player->RemoveUnchangedGroupUpdateFlags(sendTo))
         return;
 
     WorldPacket data;
@@ -270,7 +270,8 @@ class TC_GAME_API Group
         void SendUpdate();
         void SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot = nullptr);
         void Update(time_t diff);
-        void UpdatePlayerOutOfRange(Player* pPlayer);
+        // Send player stats changes to group members out of its visibility range. If onlyChangedValues, skip values these members already have
+        void UpdatePlayerOutOfRange(Player* pPlayer, bool onlyChangedValues = false);
 
         template<class Worker>
         void BroadcastWorker(Worker& worker)
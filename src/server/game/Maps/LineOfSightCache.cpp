@@ -0,0 +1,160 @@
+#include "LineOfSightCache.h"
+#include "GameTime.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+LineOfSightCache::LineOfSightCache() : _stamp(1), _fullInvalidationStamp(1), _hits(0), _misses(0)
+{
+}
+
+bool LineOfSightCache::Key::operator==(Key const& right) const
+{
+    for (uint32 i = 0; i < 6; ++i)
+        if (Coords[i] != right.Coords[i])
+            return false;
+
+    return PhaseMask == right.PhaseMask && Flags == right.Flags;
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 flags)
+{
+    Key key;
+    float const coords[6] = { x1, y1, z1, x2, y2, z2 };
+    for (uint32 i = 0; i < 6; ++i)
+        key.Coords[i] = int32(std::floor(coords[i] / QUANTIZATION));
+    key.PhaseMask = phasemask;
+    key.Flags = flags;
+    return key;
+}
+
+uint32 LineOfSightCache::GetSlot(Key const& key)
+{
+    uint32 hash = 2166136261u;
+    for (int32 coord : key.Coords)
+        hash = (hash ^ uint32(coord)) * 16777619u;
+    hash = (hash ^ key.PhaseMask) * 16777619u;
+    hash = (hash ^ key.Flags) * 16777619u;
+    return (hash ^ (hash >> 15)) & (ENTRY_COUNT - 1);
+}
+
+LineOfSightCache::CellRange LineOfSightCache::GetCellRange(float minX, float minY, float maxX, float maxY)
+{
+    CellRange range;
+    range.MinX = int32(std::floor(minX / CELL_SIZE));
+    range.MinY = int32(std::floor(minY / CELL_SIZE));
+    range.MaxX = int32(std::floor(maxX / CELL_SIZE));
+    range.MaxY = int32(std::floor(maxY / CELL_SIZE));
+    return range;
+}
+
+uint32 LineOfSightCache::GetCellStampSlot(int32 cellX, int32 cellY)
+{
+    // cells wrap around every CELL_STAMP_SIDE cells, close cells never share a stamp
+    return (uint32(cellX) & (CELL_STAMP_SIDE - 1)) * CELL_STAMP_SIDE + (uint32(cellY) & (CELL_STAMP_SIDE - 1));
+}
+
+LineOfSightCache::CellRange LineOfSightCache::GetSegmentCellRange(float x1, float y1, float x2, float y2)
+{
+    return GetCellRange(std::min(x1, x2) - QUANTIZATION, std::min(y1, y2) - QUANTIZATION,
+        std::max(x1, x2) + QUANTIZATION, std::max(y1, y2) + QUANTIZATION);
+}
+
+uint32 LineOfSightCache::GetLastInvalidation(CellRange const& range) const
+{
+    uint32 lastInvalidation = _fullInvalidationStamp;
+    for (int32 x = range.MinX; x <= range.MaxX; ++x)
+        for (int32 y = range.MinY; y <= range.MaxY; ++y)
+            lastInvalidation = std::max(lastInvalidation, _cellStamps[GetCellStampSlot(x, y)]);
+
+    return lastInvalidation;
+}
+
+bool LineOfSightCache::Get(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 flags, bool& result)
+{
+    CellRange const range = GetSegmentCellRange(x1, y1, x2, y2);
+    if (_entries.empty() || range.GetCount() > MAX_SEGMENT_CELLS)
+    {
+        ++_misses;
+        return false;
+    }
+
+    Key const key = MakeKey(x1, y1, z1, x2, y2, z2, phasemask, flags);
+    Entry const& entry = _entries[GetSlot(key)];
+    if (int32(entry.ExpireTime - GameTime::GetGameTimeMS()) > 0 && entry.EntryKey == key && entry.Stamp >= GetLastInvalidation(range))
+    {
+        result = entry.Result;
+        ++_hits;
+        return true;
+    }
+
+    ++_misses;
+    return false;
+}
+
+void LineOfSightCache::Set(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 flags, bool result)
+{
+    if (GetSegmentCellRange(x1, y1, x2, y2).GetCount() > MAX_SEGMENT_CELLS)
+        return;
+
+    if (_entries.empty())
+    {
+        // value initialized entries have stamp 0, older than any invalidation
+        _entries.resize(ENTRY_COUNT, Entry());
+        _cellStamps.resize(CELL_STAMP_COUNT, 0);
+    }
+
+    Key const key = MakeKey(x1, y1, z1, x2, y2, z2, phasemask, flags);
+    Entry& entry = _entries[GetSlot(key)];
+    entry.EntryKey = key;
+    entry.Stamp = _stamp;
+    entry.ExpireTime = GameTime::GetGameTimeMS() + sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL);
+    entry.Result = result;
+}
+
+void LineOfSightCache::NextStamp()
+{
+    if (++_stamp == 0)
+    {
+        // wrapped around, start over with an empty cache
+        _stamp = 1;
+        _fullInvalidationStamp = 1;
+        std::fill(_entries.begin(), _entries.end(), Entry());
+        std::fill(_cellStamps.begin(), _cellStamps.end(), 0);
+    }
+}
+
+void LineOfSightCache::Invalidate()
+{
+    if (_entries.empty())
+        return;
+
+    NextStamp();
+    _fullInvalidationStamp = _stamp;
+}
+
+void LineOfSightCache::Invalidate(float minX, float minY, float maxX, float maxY)
+{
+    if (_entries.empty())
+        return;
+
+    CellRange const range = GetCellRange(minX, minY, maxX, maxY);
+    if (range.GetCount() >= CELL_STAMP_COUNT)
+    {
+        Invalidate();
+        return;
+    }
+
+    NextStamp();
+    for (int32 x = range.MinX; x <= range.MaxX; ++x)
+        for (int32 y = range.MinY; y <= range.MaxY; ++y)
+            _cellStamps[GetCellStampSlot(x, y)] = _stamp;
+}
+
+void LineOfSightCache::ConsumeStats(uint32& hits, uint32& misses)
+{
+    hits = _hits;
+    misses = _misses;
+    _hits = 0;
+    _misses = 0;
+}
@@ -0,0 +1,89 @@
+#ifndef TRINITY_LINEOFSIGHTCACHE_H
+#define TRINITY_LINEOFSIGHTCACHE_H
+
+#include "Define.h"
+#include <vector>
+
+/*
+Short lived cache of Map::isInLineOfSight results.
+
+Aggro checks, area spells and MoveInLineOfSight ask the same questions many times per second,
+especially in big fights where units barely move between two checks.
+Endpoints are quantized so that nearly identical queries share an entry, the key also holds phasemask and check flags.
+The table is direct mapped with a fixed size: a colliding query just replaces the previous entry.
+Entries expire after a TTL (vmap.LineOfSightCacheTTL).
+
+When collision changes in an area (gameobject models added, removed, moved or toggled), only entries whose segment
+crosses that area are dropped: the map is split in cells each holding the stamp of its last invalidation, and an entry
+is valid if it was set after the last invalidation of every cell its segment bounds touch. A moving transport thus only
+drops entries around its path. All entries are dropped when vmap tiles are loaded or unloaded.
+
+Like the map dynamic tree, the cache is only used by the thread currently updating the map and has no locking.
+*/
+class TC_GAME_API LineOfSightCache
+{
+public:
+    LineOfSightCache();
+
+    // Returns true and set result if an entry exists for this query
+    bool Get(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 flags, bool& result);
+    void Set(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 flags, bool result);
+    // Drop all entries
+    void Invalidate();
+    // Drop entries whose segment bounds overlap given area
+    void Invalidate(float minX, float minY, float maxX, float maxY);
+
+    // Returns hits and misses since last call
+    void ConsumeStats(uint32& hits, uint32& misses);
+
+private:
+    static uint32 const ENTRY_COUNT = 2048; // must be a power of 2
+    static float constexpr QUANTIZATION = 0.25f; // yards
+    static uint32 const CELL_STAMP_SIDE = 64; // must be a power of 2, cells CELL_STAMP_SIDE apart share a stamp and are invalidated together
+    static uint32 const CELL_STAMP_COUNT = CELL_STAMP_SIDE * CELL_STAMP_SIDE;
+    static float constexpr CELL_SIZE = 32.0f; // yards
+    static uint32 const MAX_SEGMENT_CELLS = 16; // longer segments are not cached
+
+    struct Key
+    {
+        int32 Coords[6];
+        uint32 PhaseMask;
+        uint32 Flags;
+
+        bool operator==(Key const& right) const;
+    };
+
+    struct Entry
+    {
+        Key EntryKey;
+        uint32 Stamp;
+        uint32 ExpireTime;
+        bool Result;
+    };
+
+    struct CellRange
+    {
+        int32 MinX, MinY, MaxX, MaxY;
+
+        uint32 GetCount() const { return uint32(MaxX - MinX + 1) * uint32(MaxY - MinY + 1); }
+    };
+
+    static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 flags);
+    static uint32 GetSlot(Key const& key);
+    static CellRange GetCellRange(float minX, float minY, float maxX, float maxY);
+    static uint32 GetCellStampSlot(int32 cellX, int32 cellY);
+    // Entries queried with these endpoints may have been set from endpoints up to QUANTIZATION away
+    static CellRange GetSegmentCellRange(float x1, float y1, float x2, float y2);
+    // Highest invalidation stamp of given cells
+    uint32 GetLastInvalidation(CellRange const& range) const;
+    void NextStamp();
+
+    std::vector<Entry> _entries; // allocated at first use, most maps never do line of sight checks
+    std::vector<uint32> _cellStamps;
+    uint32 _stamp; // incremented at each invalidation, entries hold the value at the time they were set
+    uint32 _fullInvalidationStamp;
+    uint32 _hits;
+    uint32 _misses;
+};
+
+#endif
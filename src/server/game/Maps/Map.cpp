@@ -163,6 +163,7 @@ void Map::LoadMapAndVMap(int gx, int gy)
     {
         LoadVMap(gx, gy);
         LoadMMap(gx, gy);
+        InvalidateLineOfSightCache();
     }
 }
 
@@ -185,13 +186,13 @@ void Map::DeleteStateMachine()
 Map::Map(MapType type, uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent)
    : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
    _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false),
-   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), _lastMapUpdate(0),
+   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), _lastMapUpdate(0), _updateInterval(0),
    m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
    m_activeForcedNonPlayersIter(m_activeForcedNonPlayers.end()), 
    _transportsUpdateIter(_transports.end()),
    _defaultLight(GetDefaultMapLight(id)),
    i_mapType(type), i_gridExpiry(expiry), _respawnCheckTimer(0),
-   i_scriptLock(false), m_disableMapObjects(false)
+   i_scriptLock(false), m_disableMapObjects(false), _unitSpatialIndex(this)
 {
     m_parentMap = (_parent ? _parent : this);
     for(uint32 idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -487,6 +488,9 @@ bool Map::AddPlayerToMap(Player *player)
         return false;
     }
 
+    // back to full update rate until Monitor sees the map again
+    SetUpdateInterval(0);
+
     Cell cell(cellCoord);
     EnsureGridLoadedForActiveObject(cell, player);
     AddToGrid(player, cell);
@@ -802,6 +806,7 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 void Map::Update(const uint32 &t_diff)
 {
     _dynamicTree.update(t_diff);
+    _unitSpatialIndex.Update(t_diff);
     /// update worldsessions for existing players
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -910,6 +915,8 @@ void Map::Update(const uint32 &t_diff)
         ProcessRelocationNotifies(t_diff);
 
     sScriptMgr->OnMapUpdate(this, t_diff);
+
+    SendQueuedMonsterMoves();
 }
 
 void Map::RemovePlayerFromMap(Player *player, bool remove)
@@ -1050,6 +1057,7 @@ void Map::PlayerRelocation(Player *player, float x, float y, float z, float orie
         AddToGrid(player, new_cell);
     }
 
+    _unitSpatialIndex.UpdatePosition(player);
     player->UpdatePositionData();
     player->UpdateObjectVisibility(false);
 }
@@ -1077,6 +1085,7 @@ void Map::CreatureRelocation(Creature *creature, float x, float y, float z, floa
         if (creature->IsVehicle())
             creature->GetVehicleKit()->RelocatePassengers();
 #endif
+        _unitSpatialIndex.UpdatePosition(creature);
         creature->UpdateObjectVisibility(false);
         creature->UpdatePositionData();
         RemoveCreatureFromMoveList(creature);
@@ -1234,6 +1243,7 @@ void Map::MoveAllCreaturesInMoveList()
         if (c->IsVehicle())
             c->GetVehicleKit()->RelocatePassengers();
 #endif
+            _unitSpatialIndex.UpdatePosition(c);
             c->UpdatePositionData();
             c->UpdateObjectVisibility(false);
         }
@@ -1538,6 +1548,7 @@ bool Map::CreatureRespawnRelocation(Creature *c, bool diffGridOnly)
     if(CreatureCellRelocation(c,resp_cell))
     {
         c->Relocate(resp_x, resp_y, resp_z, resp_o);
+        _unitSpatialIndex.UpdatePosition(c);
         c->GetMotionMaster()->Initialize(); // prevent possible problems with default move generators
         //CreatureRelocationNotify(c,resp_cell,resp_cell.GetCellCoord());
         c->UpdatePositionData();
@@ -1642,6 +1653,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             }
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+            InvalidateLineOfSightCache();
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy)); 
@@ -1880,6 +1892,27 @@ float Map::GetGridMapHeight(float x, float y) const
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
+void Map::GetGridMapHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    uint32 first = 0;
+    while (first < count)
+    {
+        // same grid computation as GetGrid
+        int gx = (int)(32 - x[first] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[first] / SIZE_OF_GRIDS);
+        uint32 last = first + 1;
+        while (last < count && (int)(32 - x[last] / SIZE_OF_GRIDS) == gx && (int)(32 - y[last] / SIZE_OF_GRIDS) == gy)
+            ++last;
+
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x[first], y[first]))
+            gmap->getHeights(x + first, y + first, heights + first, last - first);
+        else
+            std::fill(heights + first, heights + last, VMAP_INVALID_HEIGHT_VALUE);
+
+        first = last;
+    }
+}
+
 float Map::GetVMapFloor(float x, float y, float z, float maxSearchDist, float collisionHeight) const
 {
     return VMAP::VMapFactory::createOrGetVMapManager()->getHeight(GetId(), x, y, z + collisionHeight, maxSearchDist);
@@ -2235,13 +2268,69 @@ float Map::GetGameObjectCeil(uint32 phasemask, float x, float y, float z, float
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
+    bool const useCache = sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL) != 0;
+    uint32 const cacheFlags = uint32(checks) | (uint32(ignoreFlags) << 8);
+    bool result;
+    if (useCache && _lineOfSightCache.Get(x1, y1, z1, x2, y2, z2, phasemask, cacheFlags, result))
+        return result;
+
+    result = true;
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
         && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
-        return false;
-    if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
+        result = false;
+    else if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
         && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
-        return false;
-    return true;
+        result = false;
+
+    if (useCache)
+        _lineOfSightCache.Set(x1, y1, z1, x2, y2, z2, phasemask, cacheFlags, result);
+    return result;
+}
+
+void Map::isInLineOfSightMulti(std::vector<VMAP::LineOfSightSegment> const& segments, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, std::vector<bool>& results) const
+{
+    results.assign(segments.size(), true);
+
+    bool const useCache = sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL) != 0;
+    uint32 const cacheFlags = uint32(checks) | (uint32(ignoreFlags) << 8);
+
+    // only compute segments missing from cache
+    std::vector<uint32> pendingIndexes;
+    std::vector<VMAP::LineOfSightSegment> pendingSegments;
+    pendingIndexes.reserve(segments.size());
+    pendingSegments.reserve(segments.size());
+    for (uint32 i = 0; i < segments.size(); ++i)
+    {
+        VMAP::LineOfSightSegment const& segment = segments[i];
+        bool result;
+        if (useCache && _lineOfSightCache.Get(segment.x1, segment.y1, segment.z1, segment.x2, segment.y2, segment.z2, phasemask, cacheFlags, result))
+        {
+            results[i] = result;
+            continue;
+        }
+
+        pendingIndexes.push_back(i);
+        pendingSegments.push_back(segment);
+    }
+
+    if (pendingSegments.empty())
+        return;
+
+    std::vector<bool> pendingResults(pendingSegments.size(), true);
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSightMulti(GetId(), pendingSegments, ignoreFlags, pendingResults);
+    if (checks & LINEOFSIGHT_CHECK_GOBJECT)
+        _dynamicTree.isInLineOfSightMulti(pendingSegments, phasemask, pendingResults);
+
+    for (uint32 i = 0; i < pendingSegments.size(); ++i)
+    {
+        results[pendingIndexes[i]] = pendingResults[i];
+        if (useCache)
+        {
+            VMAP::LineOfSightSegment const& segment = pendingSegments[i];
+            _lineOfSightCache.Set(segment.x1, segment.y1, segment.z1, segment.x2, segment.y2, segment.z2, phasemask, cacheFlags, pendingResults[i]);
+        }
+    }
 }
 
 bool Map::IsInWater(float x, float y, float pZ, LiquidData *data) const
@@ -2415,15 +2504,13 @@ void Map::AddFarSpellCallback(FarSpellCallback&& callback)
 
 void Map::DelayedUpdate(const uint32 t_diff)
 {
-    {
-        FarSpellCallback* callback;
-        while (_farSpellCallbacks.Dequeue(callback))
-        {
-            (*callback)(this);
-            delete callback;
-        }
-    }
+    ProcessFarSpellCallbacks();
+    DelayedUpdateTransports(t_diff);
+    UpdateRemovedObjectsAndGrids(t_diff);
+}
 
+void Map::DelayedUpdateTransports(uint32 t_diff)
+{
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
         MotionTransport* transport = *_transportsUpdateIter;
@@ -2434,7 +2521,20 @@ void Map::DelayedUpdate(const uint32 t_diff)
 
         transport->DelayedUpdate(t_diff);
     }
+}
+
+void Map::ProcessFarSpellCallbacks()
+{
+    FarSpellCallback* callback;
+    while (_farSpellCallbacks.Dequeue(callback))
+    {
+        (*callback)(this);
+        delete callback;
+    }
+}
 
+void Map::UpdateRemovedObjectsAndGrids(uint32 t_diff)
+{
     RemoveAllObjectsInRemoveList();
 
     // Don't unload grids if it's battleground, since we may have manually added GOs, creatures, those doesn't load from DB at grid re-load !
@@ -2644,6 +2744,33 @@ Corpse* Map::GetCorpse(ObjectGuid const& guid)
     return _objectsStore.Find<Corpse>(guid);
 }
 
+void Map::QueueMonsterMove(Unit const* unit, uint32 splineId, WorldPacket&& packet)
+{
+    QueuedMonsterMove& move = _queuedMonsterMoves[unit->GetGUID()];
+    move.SplineId = splineId;
+    move.Packet = std::move(packet);
+}
+
+void Map::DiscardMonsterMove(Unit const* unit)
+{
+    if (!_queuedMonsterMoves.empty())
+        _queuedMonsterMoves.erase(unit->GetGUID());
+}
+
+void Map::SendQueuedMonsterMoves()
+{
+    for (auto& pair : _queuedMonsterMoves)
+    {
+        Unit* unit = pair.first.IsPet() ? GetPet(pair.first) : GetCreature(pair.first);
+        // a spline replaced by a stop was superseded by its packet
+        if (!unit || !unit->IsInWorld() || unit->movespline->GetId() != pair.second.SplineId)
+            continue;
+
+        unit->SendMessageToSet(&pair.second.Packet, true);
+    }
+    _queuedMonsterMoves.clear();
+}
+
 Creature* Map::GetCreature(ObjectGuid guid)
 {
     return _objectsStore.Find<Creature>(guid);
@@ -4163,7 +4290,7 @@ void Map::AddRespawnInfo(RespawnInfo& info, bool replace)
 
     // if we get to this point, we should insert the respawninfo (there either was no prior entry, or it was deleted already)
     RespawnInfo * ri = new RespawnInfo(info);
-    ri->handle = _respawnTimes.push(ri);
+    _respawnTimes.Insert(ri);
     bool success = bySpawnIdMap.emplace(ri->spawnId, ri).second;
     ASSERT(success, "Insertion of respawn info with id (%u,%u) into spawn id map failed - state desync.", uint32(ri->type), ri->spawnId);
 }
@@ -4193,9 +4320,11 @@ RespawnInfo* Map::GetRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawn
 
 void Map::DeleteRespawnInfo() // delete everything
 {
-    for (RespawnInfo* info : _respawnTimes)
-        delete info;
-    _respawnTimes.clear();
+    for (auto const& pair : _creatureRespawnTimesBySpawnId)
+        delete pair.second;
+    for (auto const& pair : _gameObjectRespawnTimesBySpawnId)
+        delete pair.second;
+    _respawnTimes.Clear();
     _creatureRespawnTimesBySpawnId.clear();
     _gameObjectRespawnTimesBySpawnId.clear();
 }
@@ -4209,8 +4338,8 @@ void Map::DeleteRespawnInfo(RespawnInfo* info)
     size_t const n = GetRespawnMapForType(info->type).erase(info->spawnId);
     ASSERT(n == 1, "Respawn stores inconsistent for map %u, spawnid %u (type %u)", GetId(), info->spawnId, uint32(info->type));
 
-    //respawn heap
-    _respawnTimes.erase(info->handle);
+    //respawn queue
+    _respawnTimes.Erase(info);
 
     // then cleanup the object
     delete info;
@@ -4254,29 +4383,26 @@ void Map::RemoveRespawnTime(std::vector<RespawnInfo*>& respawnData, bool doRespa
 void Map::ProcessRespawns()
 {
     time_t now = time(NULL);
-    while (!_respawnTimes.empty())
+    while (RespawnInfo* next = _respawnTimes.GetNextDue(now))
     {
-        RespawnInfo* next = _respawnTimes.top();
-        if (now < next->respawnTime) // done for this tick
-            break;
         if (CheckRespawn(next)) // see if we're allowed to respawn
         {
             // ok, respawn
-            _respawnTimes.pop();
+            _respawnTimes.Erase(next);
             GetRespawnMapForType(next->type).erase(next->spawnId);
             DoRespawn(next->type, next->spawnId, next->gridId);
             delete next;
         }
         else if (!next->respawnTime) // just remove respawn entry without rescheduling
         {
-            _respawnTimes.pop();
+            _respawnTimes.Erase(next);
             GetRespawnMapForType(next->type).erase(next->spawnId);
             delete next;
         }
-        else // value changed, update heap position
+        else // value changed, move to its new bucket
         {
             ASSERT(now < next->respawnTime); // infinite loop guard
-            _respawnTimes.decrease(next->handle);
+            _respawnTimes.Reschedule(next);
         }
     }
 }
@@ -4469,6 +4595,7 @@ void Map::RemoveGameObjectModel(GameObjectModel const& model)
 { 
     TC_LOG_TRACE("maps", "Map %u - Removed model %s", GetId(), model.name.c_str());
     _dynamicTree.remove(model); 
+    InvalidateLineOfSightCache(model.getBounds());
 }
 
 void Map::InsertGameObjectModel(GameObjectModel const& model) 
@@ -4476,6 +4603,7 @@ void Map::InsertGameObjectModel(GameObjectModel const& model)
     TC_LOG_TRACE("maps", "Map %u - Added model %s", GetId(), model.name.c_str());
     DEBUG_ASSERT(!_dynamicTree.contains(model));
     _dynamicTree.insert(model); 
+    InvalidateLineOfSightCache(model.getBounds());
 }
 
 bool Map::ContainsGameObjectModel(GameObjectModel const& model) const 
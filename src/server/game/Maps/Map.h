@@ -10,12 +10,17 @@
 #include "MPSCQueue.h"
 #include "DynamicTree.h"
 #include "Models/GameObjectModel.h"
-#include <boost/heap/fibonacci_heap.hpp>
+#include "IVMapManager.h"
 #include "ObjectGuid.h"
 #include "SpawnData.h"
 #include "Transaction.h"
 #include "SharedDefines.h"
+#include "UnitSpatialIndex.h"
+#include "LineOfSightCache.h"
+#include "RespawnQueue.h"
+#include "WorldPacket.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
 #include <mutex>
@@ -122,36 +127,8 @@ struct ZoneDynamicInfo
 #endif
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
-struct RespawnInfo; // forward declaration
-struct CompareRespawnInfo
-{
-    bool operator()(RespawnInfo const* a, RespawnInfo const* b) const;
-};
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
-typedef boost::heap::fibonacci_heap<RespawnInfo*, boost::heap::compare<CompareRespawnInfo>> RespawnListContainer;
-typedef RespawnListContainer::handle_type RespawnListHandle;
 typedef std::unordered_map<uint32, RespawnInfo*> RespawnInfoMap;
-struct RespawnInfo
-{
-    SpawnObjectType type;
-    ObjectGuid::LowType spawnId;
-    uint32 entry;
-    time_t respawnTime;
-    uint32 gridId;
-    uint32 zoneId;
-    RespawnListHandle handle;
-};
-inline bool CompareRespawnInfo::operator()(RespawnInfo const* a, RespawnInfo const* b) const
-{
-    if (a == b)
-        return false;
-    if (a->respawnTime != b->respawnTime)
-        return (a->respawnTime > b->respawnTime);
-    if (a->spawnId != b->spawnId)
-        return a->spawnId < b->spawnId;
-    ASSERT(a->type != b->type, "Duplicate respawn entry for spawnId (%u,%u) found!", a->type, a->spawnId);
-    return a->type < b->type;
-}
 
 enum MapType
 {
@@ -243,6 +220,11 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 			_updateObjects.erase(obj);
 		}
 
+        // Monster move packets of creatures are sent at the end of map update, a creature launching several splines in the same update only sends the last one
+        void QueueMonsterMove(Unit const* unit, uint32 splineId, WorldPacket&& packet);
+        // Drop the queued monster move of unit, for a spline interrupted before it was sent. Relaunched or stopped splines don't need it, a spline finished before the end of the update is still sent
+        void DiscardMonsterMove(Unit const* unit);
+
         // some calls like isInWater should not use vmaps due to processor power
         // can return INVALID_HEIGHT if under z+2 z coord not found height
         float _GetHeight(float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
@@ -254,6 +236,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetHeight(float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, float collisionHeight = 0.0f, bool walkableOnly = false) const;
         float GetMinHeight(float x, float y) const;
         float GetGridMapHeight(float x, float y) const;
+        // GetGridMapHeight for count points. Consecutive points in the same grid share the grid lookup
+        void GetGridMapHeights(float const* x, float const* y, float* heights, uint32 count) const;
         float GetVMapFloor(float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, float collisionHeight = 0.0f) const;
         /* Get map level (checking vmaps) or liquid level at given point */
         float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = 2.03128f, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const; // 2.03128f = DEFAULT_COLLISION_HEIGHT in Object.h
@@ -277,7 +261,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // isInLineOfSight for several segments at once, results get one entry per segment. Results are stored in the line of sight cache
+        void isInLineOfSightMulti(std::vector<VMAP::LineOfSightSegment> const& segments, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, std::vector<bool>& results) const;
         void Balance() { _dynamicTree.balance(); }
+        // Must be called when something changing line of sight results is modified (gameobject collision, vmap tiles)
+        void InvalidateLineOfSightCache() { _lineOfSightCache.Invalidate(); }
+        void InvalidateLineOfSightCache(G3D::AABox const& bounds) { _lineOfSightCache.Invalidate(bounds.low().x, bounds.low().y, bounds.high().x, bounds.high().y); }
+        LineOfSightCache& GetLineOfSightCache() { return _lineOfSightCache; }
         //get dynamic collision (gameobjects only ?)
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
@@ -376,6 +366,12 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject *obj);
         void AddObjectToSwitchList(WorldObject *obj, bool on);
         virtual void DelayedUpdate(const uint32 diff);
+        // DelayedUpdate steps, in this order. When delayed updates are done in parallel, MapManager runs each step for all maps before the next one.
+        // Far spell callbacks and removals only touch this map and may run concurrently with other maps
+        void ProcessFarSpellCallbacks();
+        // Transports may move themselves and their passengers to another map, this must be done while no other map is updated
+        void DelayedUpdateTransports(uint32 diff);
+        void UpdateRemovedObjectsAndGrids(uint32 diff);
 
 		void LoadCorpseData();
 		void DeleteCorpseData();
@@ -535,6 +531,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		}
 
 		uint32 GetLastMapUpdateTime() const { return _lastMapUpdate; }
+        // Minimum time between two updates, set by Monitor for maps without players. 0 to update at every world update
+        // Set from map update threads and from the world thread when a player is added, while update threads read it
+        uint32 GetUpdateInterval() const { return _updateInterval.load(std::memory_order_relaxed); }
+        void SetUpdateInterval(uint32 interval) { _updateInterval.store(interval, std::memory_order_relaxed); }
+        bool IsUpdateDue() const { return GetMSTimeDiffToNow(_lastMapUpdate) >= GetUpdateInterval(); }
+
+        // Index of units positions, used by area spell target searches
+        UnitSpatialIndex& GetUnitSpatialIndex() { return _unitSpatialIndex; }
 
     private:
 
@@ -600,6 +604,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		void ScriptsProcess();
 
 		void SendObjectUpdates();
+        void SendQueuedMonsterMoves();
 
         bool AllTransportsEmpty() const; // sunwell
         void AllTransportsRemovePassengers(); // sunwell
@@ -618,6 +623,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable LineOfSightCache _lineOfSightCache;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -766,7 +772,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         typedef std::map<uint32, std::set<ObjectGuid> > CreaturePoolMember;
         CreaturePoolMember m_cpmembers;
 
-        RespawnListContainer _respawnTimes;
+        RespawnQueue         _respawnTimes;
         RespawnInfoMap       _creatureRespawnTimesBySpawnId;
         RespawnInfoMap       _gameObjectRespawnTimesBySpawnId;
         RespawnInfoMap& GetRespawnMapForType(SpawnObjectType type) { return (type == SPAWN_TYPE_GAMEOBJECT) ? _gameObjectRespawnTimesBySpawnId : _creatureRespawnTimesBySpawnId; }
@@ -800,10 +806,20 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 		std::unordered_set<Corpse*> _corpseBones;
 
 		std::unordered_set<Object*> _updateObjects;
+
+        struct QueuedMonsterMove
+        {
+            uint32 SplineId;
+            WorldPacket Packet;
+        };
+        std::unordered_map<ObjectGuid, QueuedMonsterMove> _queuedMonsterMoves;
         uint32 _lastMapUpdate;
+        std::atomic<uint32> _updateInterval;
 
         MPSCQueue<FarSpellCallback> _farSpellCallbacks;
 
+        UnitSpatialIndex _unitSpatialIndex;
+
 		time_t i_gridExpiry;
 
 		//used for fast base_map (e.g. MapInstanced class object) search for
@@ -73,6 +73,7 @@ void MapInstanced::Update(const uint32& t)
 
 }
 
+// MapManager::Update follows the same order when map delayed updates are done in parallel
 void MapInstanced::DelayedUpdate(const uint32 diff)
 {
     for (auto & m_InstancedMap : m_InstancedMaps)
@@ -33,14 +33,17 @@ class TC_GAME_API MapInstanced : public Map
         bool DestroyInstance(uint32 InstanceId);
         bool DestroyInstance(InstancedMaps::iterator &itr);
 
+        // may be called by several instances at once, from map update threads
         void AddGridMapReference(GridCoord const& p)
         {
+            std::lock_guard<std::mutex> lock(_gridMapReferenceLock);
             ++GridMapReference[p.x_coord][p.y_coord];
             SetUnloadReferenceLock(GridCoord((MAX_NUMBER_OF_GRIDS - 1) - p.x_coord, (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord), true);
         }
 
         void RemoveGridMapReference(GridCoord const& p)
         {
+            std::lock_guard<std::mutex> lock(_gridMapReferenceLock);
             --GridMapReference[p.x_coord][p.y_coord];
             if (!GridMapReference[p.x_coord][p.y_coord])
                 SetUnloadReferenceLock(GridCoord((MAX_NUMBER_OF_GRIDS - 1) - p.x_coord, (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord), false);
@@ -61,6 +64,7 @@ class TC_GAME_API MapInstanced : public Map
         InstancedMaps m_InstancedMaps;
 
         uint16 GridMapReference[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::mutex _gridMapReferenceLock;
 };
 #endif
 
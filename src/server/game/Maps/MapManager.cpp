@@ -235,8 +235,52 @@ void MapManager::Update(time_t diff)
     }
 
     //delayed map updates. Keep in mind that TC has a logic where a delayed update always follow an unique update, we don't. This is not a problem atm but this expectation may cause problem if delayed logic is changed later.
-    for (auto & i_map : i_maps)
-        i_map.second->DelayedUpdate(uint32(i_timer.GetCurrent()));
+    if (m_updater.activated() && sWorld->getBoolConfig(CONFIG_MAP_PARALLEL_DELAYED_UPDATE))
+    {
+        uint32 const diff = uint32(i_timer.GetCurrent());
+        // same order as MapInstanced::DelayedUpdate, instances before their base map
+        std::vector<Map*> maps;
+        std::vector<Map*> removalMaps; // continents and instances, every map except instanced base maps
+        std::vector<MapInstanced*> instancedMaps;
+        for (auto& i_map : i_maps)
+        {
+            if (MapInstanced* mapInstanced = i_map.second->ToMapInstanced())
+            {
+                for (auto& instancePair : mapInstanced->GetInstancedMaps())
+                {
+                    maps.push_back(instancePair.second);
+                    removalMaps.push_back(instancePair.second);
+                }
+                instancedMaps.push_back(mapInstanced);
+            }
+            else
+                removalMaps.push_back(i_map.second);
+            maps.push_back(i_map.second);
+        }
+
+        // Each map goes through the Map::DelayedUpdate steps in the same order as a sequential update, only the order between maps changes.
+        // Far spell callbacks queued by a map while another one processes its own are handled at next update, as they would be if that map was updated first.
+        for (Map* map : maps)
+            m_updater.schedule_delayed_update(*map, diff, MAP_DELAYED_UPDATE_FAR_SPELL_CALLBACKS);
+        m_updater.waitUpdateLoops();
+
+        // cross map part, on this thread only
+        for (Map* map : maps)
+            map->DelayedUpdateTransports(diff);
+
+        // instanced base maps grids are referenced by their instances, unload them once instances are done
+        for (Map* map : removalMaps)
+            m_updater.schedule_delayed_update(*map, diff, MAP_DELAYED_UPDATE_REMOVED_OBJECTS_AND_GRIDS);
+        m_updater.waitUpdateLoops();
+
+        for (MapInstanced* mapInstanced : instancedMaps)
+            mapInstanced->UpdateRemovedObjectsAndGrids(diff);
+    }
+    else
+    {
+        for (auto & i_map : i_maps)
+            i_map.second->DelayedUpdate(uint32(i_timer.GetCurrent()));
+    }
 
     i_timer.SetCurrent(0);
 }
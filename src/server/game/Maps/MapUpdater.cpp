@@ -18,25 +18,45 @@ class MapUpdateRequest
         MapUpdater& m_updater;
         uint32 m_diff;
         uint32 m_loopCount;
+        MapDelayedUpdateStep m_delayedStep;
 
     public:
 
-        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d) :
+        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, MapDelayedUpdateStep delayedStep = MAP_DELAYED_UPDATE_NONE) :
             m_map(m), 
             m_updater(u), 
             m_diff(d), 
-            m_loopCount(0)
+            m_loopCount(0),
+            m_delayedStep(delayedStep)
         {
         }
 
         Map const* getMap() { return &m_map; }
 
-        void call()
+        // return false if map was skipped because it is not due for an update yet
+        bool call()
         {
+            switch (m_delayedStep)
+            {
+                case MAP_DELAYED_UPDATE_FAR_SPELL_CALLBACKS:
+                    m_map.ProcessFarSpellCallbacks();
+                    return true;
+                case MAP_DELAYED_UPDATE_REMOVED_OBJECTS_AND_GRIDS:
+                    m_map.UpdateRemovedObjectsAndGrids(m_diff);
+                    return true;
+                default:
+                    break;
+            }
+
+            if (!m_map.IsUpdateDue())
+                return false;
+
             sMonitor->MapUpdateStart(m_map);
-            m_map.DoUpdate(m_diff, MINIMUM_MAP_UPDATE_INTERVAL);
+            // map may have been skipped for several world updates, allow a diff covering them
+            m_map.DoUpdate(std::max(m_diff, 2 * m_map.GetUpdateInterval()), MINIMUM_MAP_UPDATE_INTERVAL);
             sMonitor->MapUpdateEnd(m_map);
             m_loopCount++;
+            return true;
         }
 };
 
@@ -118,6 +138,16 @@ void MapUpdater::schedule_update(Map& map, uint32 diff)
     spawnMissingOnceUpdateThreads();
 }
 
+void MapUpdater::schedule_delayed_update(Map& map, uint32 diff, MapDelayedUpdateStep step)
+{
+    ASSERT(!_enable_updates_loop);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    pending_loop_maps++;
+    _loop_queue.Push(new MapUpdateRequest(map, *this, diff, step));
+}
+
 bool MapUpdater::activated()
 {
     return _loop_maps_workerThreads.size() > 0;
@@ -139,10 +169,11 @@ void MapUpdater::LoopWorkerThread(std::atomic<bool>* enable_instance_updates_loo
         }
 
         ASSERT(request);
-        request->call();
+        bool const updated = request->call();
 
         //repush at end of queue, or delete if loop has been disabled by MapManager
-        if(!(*enable_instance_updates_loop))
+        //skipped maps are done for this world update, they'll be scheduled again at next one
+        if(!updated || !(*enable_instance_updates_loop))
         {
             delete request;
             loopMapFinished();
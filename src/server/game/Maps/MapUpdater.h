@@ -11,6 +11,14 @@
 class MapUpdateRequest;
 class Map;
 
+// Map::DelayedUpdate steps which may be run on update threads
+enum MapDelayedUpdateStep
+{
+    MAP_DELAYED_UPDATE_NONE,
+    MAP_DELAYED_UPDATE_FAR_SPELL_CALLBACKS,
+    MAP_DELAYED_UPDATE_REMOVED_OBJECTS_AND_GRIDS,
+};
+
 /**
 Two kinds of maps:
 - Maps we update only once (continents, instances base maps)
@@ -26,6 +34,8 @@ public:
     friend class MapUpdateRequest;
 
     void schedule_update(Map& map, uint32 diff);
+    //run given Map::DelayedUpdate step on loop workers, use waitUpdateLoops to wait for them. Update loop must be disabled.
+    void schedule_delayed_update(Map& map, uint32 diff, MapDelayedUpdateStep step);
 
     void waitUpdateOnces();
     //when enabled, instance update requests are re enqueued instead of consumed
@@ -0,0 +1,105 @@
+#include "RespawnQueue.h"
+#include "Errors.h"
+#include "ObjectPool.h"
+#include <algorithm>
+
+void* RespawnInfo::operator new(size_t size)
+{
+    return ObjectPool<RespawnInfo>::Allocate(size, "RespawnInfo");
+}
+
+void RespawnInfo::operator delete(void* ptr, size_t size)
+{
+    ObjectPool<RespawnInfo>::Deallocate(ptr, size, "RespawnInfo");
+}
+
+RespawnQueue::RespawnQueue(time_t now) : _buckets(BUCKET_COUNT + 1, nullptr), _cursor(now), _nextOverflowScan(now + BUCKET_COUNT / 2), _size(0)
+{
+}
+
+void RespawnQueue::Link(RespawnInfo* info, uint32 bucket)
+{
+    info->_bucket = bucket;
+    info->_prev = nullptr;
+    info->_next = _buckets[bucket];
+    if (info->_next)
+        info->_next->_prev = info;
+    _buckets[bucket] = info;
+}
+
+void RespawnQueue::Insert(RespawnInfo* info)
+{
+    // respawns already due go in the bucket processed next
+    time_t const time = std::max(info->respawnTime, _cursor);
+    if (time - _cursor < time_t(BUCKET_COUNT))
+        Link(info, uint32(time) & (BUCKET_COUNT - 1));
+    else
+        Link(info, OVERFLOW_BUCKET);
+
+    ++_size;
+}
+
+void RespawnQueue::Erase(RespawnInfo* info)
+{
+    ASSERT(_size);
+
+    if (info->_prev)
+        info->_prev->_next = info->_next;
+    else
+    {
+        ASSERT(_buckets[info->_bucket] == info, "Respawn (%u,%u) is not in the respawn queue", uint32(info->type), info->spawnId);
+        _buckets[info->_bucket] = info->_next;
+    }
+
+    if (info->_next)
+        info->_next->_prev = info->_prev;
+
+    info->_prev = nullptr;
+    info->_next = nullptr;
+    --_size;
+}
+
+void RespawnQueue::Clear()
+{
+    std::fill(_buckets.begin(), _buckets.end(), nullptr);
+    _size = 0;
+}
+
+void RespawnQueue::ScanOverflow()
+{
+    // buckets can take respawns up to BUCKET_COUNT seconds ahead, scanning every half turn moves respawns at least half a turn before they are due
+    _nextOverflowScan = _cursor + BUCKET_COUNT / 2;
+
+    RespawnInfo* info = _buckets[OVERFLOW_BUCKET];
+    while (info)
+    {
+        RespawnInfo* next = info->_next;
+        if (info->respawnTime - _cursor < time_t(BUCKET_COUNT))
+        {
+            Erase(info);
+            Insert(info);
+        }
+        info = next;
+    }
+}
+
+RespawnInfo* RespawnQueue::GetNextDue(time_t now)
+{
+    if (_cursor > now)
+        return nullptr;
+
+    // the cursor stays on current second, so that respawns already due and inserted later this second are still found
+    for (;;)
+    {
+        if (_cursor >= _nextOverflowScan)
+            ScanOverflow();
+
+        if (RespawnInfo* info = _buckets[uint32(_cursor) & (BUCKET_COUNT - 1)])
+            return info;
+
+        if (_cursor == now)
+            return nullptr;
+
+        ++_cursor;
+    }
+}
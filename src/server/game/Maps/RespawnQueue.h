@@ -0,0 +1,72 @@
+#ifndef TRINITY_RESPAWNQUEUE_H
+#define TRINITY_RESPAWNQUEUE_H
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include "SpawnData.h"
+#include <ctime>
+#include <vector>
+
+struct RespawnInfo
+{
+    SpawnObjectType type;
+    ObjectGuid::LowType spawnId;
+    uint32 entry;
+    time_t respawnTime;
+    uint32 gridId;
+    uint32 zoneId;
+
+    // allocated from ObjectPool
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
+private:
+    friend class RespawnQueue;
+
+    // position in RespawnQueue, managed by the queue
+    RespawnInfo* _prev = nullptr;
+    RespawnInfo* _next = nullptr;
+    uint32 _bucket = 0;
+};
+
+/*
+Calendar queue of pending respawns, with one bucket per second.
+
+Buckets cover the next BUCKET_COUNT seconds, respawns later than that wait in an overflow list
+scanned every half turn of the calendar and moved into their bucket when they get close enough.
+Respawns are linked in their bucket through RespawnInfo itself: insert, erase and reschedule are O(1)
+and do not allocate, finding the next due respawn only walks the seconds elapsed since last call.
+Respawns due the same second are not ordered.
+*/
+class TC_GAME_API RespawnQueue
+{
+public:
+    explicit RespawnQueue(time_t now = time(nullptr));
+
+    void Insert(RespawnInfo* info);
+    void Erase(RespawnInfo* info);
+    // Move info after its respawnTime changed
+    void Reschedule(RespawnInfo* info) { Erase(info); Insert(info); }
+    // Drop all respawns, without deleting them
+    void Clear();
+
+    // Returns a respawn due at given time or nullptr if there is none. It stays in the queue until erased or rescheduled
+    RespawnInfo* GetNextDue(time_t now);
+
+    bool empty() const { return _size == 0; }
+    uint32 size() const { return _size; }
+
+private:
+    static uint32 const BUCKET_COUNT = 4096; // must be a power of 2
+    static uint32 const OVERFLOW_BUCKET = BUCKET_COUNT;
+
+    void Link(RespawnInfo* info, uint32 bucket);
+    void ScanOverflow();
+
+    std::vector<RespawnInfo*> _buckets; // BUCKET_COUNT buckets + the overflow list
+    time_t _cursor;                     // last second processed, its bucket holds respawns already due
+    time_t _nextOverflowScan;
+    uint32 _size;
+};
+
+#endif
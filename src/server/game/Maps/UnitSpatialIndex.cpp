@@ -0,0 +1,303 @@
+#include "UnitSpatialIndex.h"
+#include "Map.h"
+#include "Player.h"
+#include "Pet.h"
+
+// Minimal bucket size, buckets get bigger on very large maps to keep the bucket count bounded
+#define UNIT_INDEX_MIN_BUCKET_SIZE        16.0f
+#define UNIT_INDEX_MAX_BUCKETS_PER_AXIS   256
+// How far a unit may move away from its bucket before being moved to the overflow area
+#define UNIT_INDEX_RELOCATION_SLACK       10.0f
+// Force a rebuild from time to time, in case some positions were changed without going through map relocation
+#define UNIT_INDEX_REBUILD_INTERVAL       2000
+#define UNIT_INDEX_MIN_OVERFLOW           64
+
+UnitSpatialIndex::UnitSpatialIndex(Map* map) : _map(map), _built(false), _rebuildTimer(UNIT_INDEX_REBUILD_INTERVAL),
+    _minX(0.0f), _minY(0.0f), _bucketSize(UNIT_INDEX_MIN_BUCKET_SIZE), _bucketCountX(0), _bucketCountY(0), _sortedCount(0),
+    _removedCount(0), _maxReach(0.0f)
+{
+}
+
+void UnitSpatialIndex::Invalidate()
+{
+    _built = false;
+}
+
+void UnitSpatialIndex::Update(uint32 diff)
+{
+    if (_rebuildTimer <= diff)
+    {
+        Invalidate();
+        _rebuildTimer = UNIT_INDEX_REBUILD_INTERVAL;
+    }
+    else
+        _rebuildTimer -= diff;
+}
+
+uint32 UnitSpatialIndex::GetBucketIndex(float x, float y) const
+{
+    int32 bx = int32((x - _minX) / _bucketSize);
+    int32 by = int32((y - _minY) / _bucketSize);
+    bx = std::min(std::max(bx, 0), int32(_bucketCountX) - 1);
+    by = std::min(std::max(by, 0), int32(_bucketCountY) - 1);
+    return uint32(by) * _bucketCountX + uint32(bx);
+}
+
+void UnitSpatialIndex::AppendEntry(Unit* unit)
+{
+    unit->m_spatialIndexSlot = uint32(_units.size());
+    _posX.push_back(unit->GetPositionX());
+    _posY.push_back(unit->GetPositionY());
+    _reach.push_back(unit->GetCombatReach());
+    _typeMask.push_back(unit->GetTypeId() == TYPEID_PLAYER ? GRID_MAP_TYPE_MASK_PLAYER : GRID_MAP_TYPE_MASK_CREATURE);
+    _units.push_back(unit);
+    _bucket.push_back(0);
+    _maxReach = std::max(_maxReach, unit->GetCombatReach());
+}
+
+void UnitSpatialIndex::Build()
+{
+    std::vector<Unit*> units;
+    units.reserve(_units.size());
+
+    for (MapRefManager::const_iterator itr = _map->GetPlayers().begin(); itr != _map->GetPlayers().end(); ++itr)
+        if (Player* player = itr->GetSource())
+            if (player->IsInWorld())
+                units.push_back(player);
+
+    if (auto creatures = _map->GetObjectsStore().GetContainer<Creature>())
+        for (auto const& pair : *creatures)
+            if (pair.second->IsInWorld())
+                units.push_back(pair.second);
+
+    if (auto pets = _map->GetObjectsStore().GetContainer<Pet>())
+        for (auto const& pair : *pets)
+            if (pair.second->IsInWorld())
+                units.push_back(pair.second);
+
+    _posX.clear();
+    _posY.clear();
+    _reach.clear();
+    _typeMask.clear();
+    _units.clear();
+    _bucket.clear();
+    _removedCount = 0;
+    _maxReach = 0.0f;
+    _built = true;
+    _rebuildTimer = UNIT_INDEX_REBUILD_INTERVAL;
+
+    if (units.empty())
+    {
+        _bucketCountX = _bucketCountY = 1;
+        _bucketStart.assign(2, 0);
+        _sortedCount = 0;
+        return;
+    }
+
+    float maxX = units.front()->GetPositionX();
+    float maxY = units.front()->GetPositionY();
+    _minX = maxX;
+    _minY = maxY;
+    for (Unit* unit : units)
+    {
+        _minX = std::min(_minX, unit->GetPositionX());
+        _minY = std::min(_minY, unit->GetPositionY());
+        maxX = std::max(maxX, unit->GetPositionX());
+        maxY = std::max(maxY, unit->GetPositionY());
+    }
+
+    _bucketSize = std::max(UNIT_INDEX_MIN_BUCKET_SIZE, std::max(maxX - _minX, maxY - _minY) / UNIT_INDEX_MAX_BUCKETS_PER_AXIS);
+    _bucketCountX = uint32((maxX - _minX) / _bucketSize) + 1;
+    _bucketCountY = uint32((maxY - _minY) / _bucketSize) + 1;
+
+    // counting sort by bucket
+    uint32 const bucketCount = _bucketCountX * _bucketCountY;
+    std::vector<uint32> unitBuckets(units.size());
+    _bucketStart.assign(bucketCount + 1, 0);
+    for (size_t i = 0; i < units.size(); ++i)
+    {
+        unitBuckets[i] = GetBucketIndex(units[i]->GetPositionX(), units[i]->GetPositionY());
+        ++_bucketStart[unitBuckets[i] + 1];
+    }
+    for (uint32 i = 0; i < bucketCount; ++i)
+        _bucketStart[i + 1] += _bucketStart[i];
+
+    uint32 const count = uint32(units.size());
+    _posX.resize(count);
+    _posY.resize(count);
+    _reach.resize(count);
+    _typeMask.resize(count);
+    _units.resize(count);
+    _bucket.resize(count);
+
+    std::vector<uint32> next(_bucketStart.begin(), _bucketStart.end() - 1);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Unit* unit = units[i];
+        uint32 const slot = next[unitBuckets[i]]++;
+        unit->m_spatialIndexSlot = slot;
+        _posX[slot] = unit->GetPositionX();
+        _posY[slot] = unit->GetPositionY();
+        _reach[slot] = unit->GetCombatReach();
+        _typeMask[slot] = unit->GetTypeId() == TYPEID_PLAYER ? GRID_MAP_TYPE_MASK_PLAYER : GRID_MAP_TYPE_MASK_CREATURE;
+        _units[slot] = unit;
+        _bucket[slot] = unitBuckets[i];
+        _maxReach = std::max(_maxReach, _reach[slot]);
+    }
+    _sortedCount = count;
+}
+
+void UnitSpatialIndex::AddUnit(Unit* unit)
+{
+    if (!_built)
+        return;
+
+    uint32 const slot = unit->m_spatialIndexSlot;
+    if (slot < _units.size() && _units[slot] == unit)
+        return;
+
+    AppendEntry(unit);
+    if (_units.size() - _sortedCount > std::max<uint32>(UNIT_INDEX_MIN_OVERFLOW, _sortedCount / 8))
+        Invalidate();
+}
+
+void UnitSpatialIndex::RemoveUnit(Unit* unit)
+{
+    if (!_built)
+        return;
+
+    uint32 const slot = unit->m_spatialIndexSlot;
+    if (slot >= _units.size() || _units[slot] != unit)
+        return;
+
+    _units[slot] = nullptr;
+    _typeMask[slot] = 0;
+    ++_removedCount;
+    if (_removedCount > std::max<uint32>(UNIT_INDEX_MIN_OVERFLOW, uint32(_units.size()) / 4))
+        Invalidate();
+}
+
+void UnitSpatialIndex::UpdatePosition(Unit* unit)
+{
+    if (!_built)
+        return;
+
+    uint32 const slot = unit->m_spatialIndexSlot;
+    if (slot >= _units.size() || _units[slot] != unit)
+        return;
+
+    float const x = unit->GetPositionX();
+    float const y = unit->GetPositionY();
+    _posX[slot] = x;
+    _posY[slot] = y;
+    _reach[slot] = unit->GetCombatReach();
+    _maxReach = std::max(_maxReach, _reach[slot]);
+
+    if (slot >= _sortedCount)
+        return;
+
+    // queries look for entries in buckets around their area extended by UNIT_INDEX_RELOCATION_SLACK, move the entry to the overflow area if it went further away
+    uint32 const bucket = _bucket[slot];
+    float const bucketMinX = _minX + (bucket % _bucketCountX) * _bucketSize;
+    float const bucketMinY = _minY + (bucket / _bucketCountX) * _bucketSize;
+    if (x >= bucketMinX - UNIT_INDEX_RELOCATION_SLACK && x <= bucketMinX + _bucketSize + UNIT_INDEX_RELOCATION_SLACK
+        && y >= bucketMinY - UNIT_INDEX_RELOCATION_SLACK && y <= bucketMinY + _bucketSize + UNIT_INDEX_RELOCATION_SLACK)
+        return;
+
+    _units[slot] = nullptr;
+    _typeMask[slot] = 0;
+    ++_removedCount;
+    AddUnit(unit);
+}
+
+template<class Filter>
+void UnitSpatialIndex::FilterRange(uint32 begin, uint32 end, float x, float y, uint32 typeMask, Filter const& filter, std::vector<Unit*>& units)
+{
+    if (begin >= end)
+        return;
+
+    uint32 const count = end - begin;
+    if (_hits.size() < count)
+        _hits.resize(count);
+
+    float const* posX = &_posX[begin];
+    float const* posY = &_posY[begin];
+    float const* reach = &_reach[begin];
+    uint8 const* typeMasks = &_typeMask[begin];
+    uint8* hits = _hits.data();
+
+    // branchless so that the compiler can vectorize it
+    for (uint32 i = 0; i < count; ++i)
+        hits[i] = uint8((typeMasks[i] & typeMask) != 0) & uint8(filter(posX[i] - x, posY[i] - y, reach[i]));
+
+    for (uint32 i = 0; i < count; ++i)
+        if (hits[i])
+            units.push_back(_units[begin + i]);
+}
+
+template<class Filter>
+void UnitSpatialIndex::Query(float x, float y, float radius, uint32 typeMask, Filter const& filter, std::vector<Unit*>& units)
+{
+    if (!_built)
+        Build();
+
+    if (_sortedCount)
+    {
+        float const searchRadius = radius + _maxReach + UNIT_INDEX_RELOCATION_SLACK;
+        int32 const lowX = std::max(int32((x - searchRadius - _minX) / _bucketSize), 0);
+        int32 const lowY = std::max(int32((y - searchRadius - _minY) / _bucketSize), 0);
+        int32 const highX = std::min(int32((x + searchRadius - _minX) / _bucketSize), int32(_bucketCountX) - 1);
+        int32 const highY = std::min(int32((y + searchRadius - _minY) / _bucketSize), int32(_bucketCountY) - 1);
+
+        // buckets of a row are contiguous, filter them in one go
+        if (lowX <= highX && lowY <= highY)
+            for (int32 by = lowY; by <= highY; ++by)
+                FilterRange(_bucketStart[by * _bucketCountX + lowX], _bucketStart[by * _bucketCountX + highX + 1], x, y, typeMask, filter, units);
+    }
+
+    FilterRange(_sortedCount, uint32(_units.size()), x, y, typeMask, filter, units);
+}
+
+void UnitSpatialIndex::GetUnitsInRange(float x, float y, float radius, uint32 typeMask, std::vector<Unit*>& units)
+{
+    Query(x, y, radius, typeMask, [radius](float dx, float dy, float reach)
+    {
+        float const maxDist = radius + reach;
+        return dx * dx + dy * dy <= maxDist * maxDist;
+    }, units);
+}
+
+void UnitSpatialIndex::GetUnitsInArc(float x, float y, float orientation, float arc, float radius, uint32 typeMask, std::vector<Unit*>& units)
+{
+    if (arc >= float(2 * M_PI))
+    {
+        GetUnitsInRange(x, y, radius, typeMask, units);
+        return;
+    }
+
+    float const dirX = std::cos(orientation);
+    float const dirY = std::sin(orientation);
+    float const cosHalfArc = std::cos(arc / 2.0f);
+    Query(x, y, radius, typeMask, [radius, dirX, dirY, cosHalfArc](float dx, float dy, float reach)
+    {
+        float const maxDist = radius + reach;
+        float const dist2 = dx * dx + dy * dy;
+        // angle to the unit is within half arc if its projection on the orientation is long enough. Small tolerance to never be stricter than Position::HasInArc
+        float const forward = dx * dirX + dy * dirY;
+        return (dist2 <= maxDist * maxDist) & (forward >= cosHalfArc * std::sqrt(dist2) - 0.01f);
+    }, units);
+}
+
+void UnitSpatialIndex::GetUnitsInLine(float x, float y, float orientation, float length, float width, uint32 typeMask, std::vector<Unit*>& units)
+{
+    float const dirX = std::cos(orientation);
+    float const dirY = std::sin(orientation);
+    Query(x, y, length, typeMask, [length, width, dirX, dirY](float dx, float dy, float reach)
+    {
+        float const maxDist = length + reach;
+        float const maxWidth = width + reach;
+        float const forward = dx * dirX + dy * dirY;
+        float const lateral = dy * dirX - dx * dirY;
+        return (dx * dx + dy * dy <= maxDist * maxDist) & (forward >= -0.01f) & (std::fabs(lateral) <= maxWidth);
+    }, units);
+}
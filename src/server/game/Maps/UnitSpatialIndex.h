@@ -0,0 +1,85 @@
+#ifndef TRINITY_UNITSPATIALINDEX_H
+#define TRINITY_UNITSPATIALINDEX_H
+
+#include "Define.h"
+#include <vector>
+
+class Map;
+class Unit;
+
+/*
+Packed uniform grid over the positions of all units in a map, used to speed up area spell target searches.
+
+Positions are stored in contiguous arrays sorted by bucket so that a query only runs a tight distance filter
+over a few array spans instead of visiting cells and calling the full target check on every object.
+The index is built lazily at the first query and then maintained:
+- Units added to world are appended to an unsorted overflow area, scanned by every query
+- Units removed from world are tombstoned
+- Units relocated through the map keep their slot as long as they stay close to their bucket, else they are moved to the overflow area
+The index is rebuilt when the overflow area or tombstones grow too much, and periodically to catch positions changed without going through map relocation.
+
+Queries are conservative: returned units may be slightly outside the requested shape, callers must still do their exact check on them.
+Returned pointers are always valid units in world at query time.
+*/
+class TC_GAME_API UnitSpatialIndex
+{
+public:
+    explicit UnitSpatialIndex(Map* map);
+
+    // Drop all data, index will be rebuilt at next query
+    void Invalidate();
+    void Update(uint32 diff);
+
+    void AddUnit(Unit* unit);
+    void RemoveUnit(Unit* unit);
+    // Must be called whenever unit position changed
+    void UpdatePosition(Unit* unit);
+
+    // Get units within 2d 'radius' (+ their combat reach) of x,y. typeMask is a GridMapTypeMask
+    void GetUnitsInRange(float x, float y, float radius, uint32 typeMask, std::vector<Unit*>& units);
+    // Same as GetUnitsInRange, limited to units within 'arc' radians centered on 'orientation' (same semantic as Position::HasInArc)
+    void GetUnitsInArc(float x, float y, float orientation, float arc, float radius, uint32 typeMask, std::vector<Unit*>& units);
+    // Get units in front of x,y at less than 'width' (+ their combat reach) of the line going toward 'orientation', up to 'length' (same semantic as Position::HasInLine)
+    void GetUnitsInLine(float x, float y, float orientation, float length, float width, uint32 typeMask, std::vector<Unit*>& units);
+
+    bool IsBuilt() const { return _built; }
+    uint32 GetUnitCount() const { return uint32(_units.size()) - _removedCount; }
+
+private:
+    void Build();
+    void AppendEntry(Unit* unit);
+    uint32 GetBucketIndex(float x, float y) const;
+
+    // Fill _hits for the given entries range and store matching units. Filter must be a bool(float dx, float dy, float reach) functor
+    template<class Filter>
+    void FilterRange(uint32 begin, uint32 end, float x, float y, uint32 typeMask, Filter const& filter, std::vector<Unit*>& units);
+    template<class Filter>
+    void Query(float x, float y, float radius, uint32 typeMask, Filter const& filter, std::vector<Unit*>& units);
+
+    Map* _map;
+    bool _built;
+    uint32 _rebuildTimer;
+
+    // bucket grid
+    float _minX;
+    float _minY;
+    float _bucketSize;
+    uint32 _bucketCountX;
+    uint32 _bucketCountY;
+    std::vector<uint32> _bucketStart;          // entries of bucket i are [ _bucketStart[i], _bucketStart[i+1] [
+    uint32 _sortedCount;                       // entries after this one are in the overflow area
+
+    // entries, structure of arrays
+    std::vector<float> _posX;
+    std::vector<float> _posY;
+    std::vector<float> _reach;
+    std::vector<uint8> _typeMask;              // GridMapTypeMask, 0 for removed entries
+    std::vector<Unit*> _units;
+    std::vector<uint32> _bucket;               // bucket of sorted entries
+    uint32 _removedCount;
+    float _maxReach;
+
+    std::vector<uint8> _hits;                  // scratch buffer for queries
+};
+
+#endif
@@ -6,7 +6,9 @@
 
 Monitor::Monitor()
     : _worldTickCount(0),
-    _generalInfoTimer(0)
+    _generalInfoTimer(0),
+    _lastLoSCacheHitRate(-1),
+    _losCacheTimer(0)
 {
     _worldTicksInfo.reserve(DAY * 20); //already prepare 1 day worth of 20 updates per seconds
 }
@@ -19,6 +21,14 @@ void Monitor::Update(uint32 diff)
     UpdateGeneralInfosIfExpired(diff);
 
     smoothTD.Update(diff);
+
+    _losCacheTimer += diff;
+    if (_losCacheTimer >= MINUTE * IN_MILLISECONDS)
+    {
+        _losCacheTimer = 0;
+        _lastLoSCacheHitRate = _monitLoSCache.GetHitRate();
+        _monitLoSCache.Reset();
+    }
 }
 
 void SmoothedTimeDiff::Update(uint32 diff)
@@ -90,6 +100,8 @@ void Monitor::MapUpdateEnd(Map& map)
     _currentWorldTickLock.unlock();
 
     _monitDynamicLoS.UpdateForMap(map, diff);
+    _monitTickRate.UpdateForMap(map, diff);
+    _monitLoSCache.UpdateForMap(map);
 
     _lastMapDiffsLock.lock();
     _lastMapDiffs[uint64(&map)] = diff;
@@ -384,3 +396,51 @@ void MonitorAlert::UpdateForWorld(uint32 diff)
     std::string msg = "/!\\ World updates have been slow for the last " + std::to_string(searchCount) + " updates with an average of " + std::to_string(avgTD);
     ChatHandler::SendGlobalGMSysMessage(msg.c_str());
 }
+
+void MonitorLineOfSightCache::UpdateForMap(Map& map)
+{
+    uint32 hits, misses;
+    map.GetLineOfSightCache().ConsumeStats(hits, misses);
+    _hits += hits;
+    _misses += misses;
+}
+
+int32 MonitorLineOfSightCache::GetHitRate() const
+{
+    uint64 const hits = _hits;
+    uint64 const total = hits + _misses;
+    if (!total)
+        return -1;
+
+    return int32(hits * 100 / total);
+}
+
+void MonitorLineOfSightCache::Reset()
+{
+    _hits = 0;
+    _misses = 0;
+}
+
+void MonitorAdaptiveTickRate::UpdateForMap(Map& map, uint32 updateCost)
+{
+    map.SetUpdateInterval(GetUpdateInterval(map, updateCost));
+}
+
+uint32 MonitorAdaptiveTickRate::GetUpdateInterval(Map& map, uint32 updateCost) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_MONITORING_ADAPTIVE_TICKRATE))
+        return 0;
+
+    // only dungeons, battlegrounds have timers and scores players expect to be exact
+    if (!map.IsDungeon() || map.GetMapType() == MAP_TYPE_TEST_MAP)
+        return 0;
+
+    if (updateCost > sWorld->getIntConfig(CONFIG_MONITORING_ADAPTIVE_TICKRATE_MAX_COST))
+        return 0;
+
+    // sessions of players in map are updated with the map, never delay their packets
+    if (map.HavePlayers())
+        return 0;
+
+    return sWorld->getIntConfig(CONFIG_MONITORING_ADAPTIVE_TICKRATE_IDLE_INTERVAL);
+}
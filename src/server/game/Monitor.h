@@ -62,6 +62,30 @@ private:
 	std::unordered_map<uint64 /*map pointer as id*/, CheckTimer> _mapCheckTimers;
 };
 
+// Lower update rate of instances without players, so that map threads spend their time on busy maps
+class MonitorAdaptiveTickRate
+{
+public:
+	void UpdateForMap(Map& map, uint32 updateCost);
+
+private:
+	uint32 GetUpdateInterval(Map& map, uint32 updateCost) const;
+};
+
+// Collect line of sight cache hits and misses of all maps
+class MonitorLineOfSightCache
+{
+public:
+	void UpdateForMap(Map& map);
+	// Hit rate in percent since last Reset, -1 if no query were made
+	int32 GetHitRate() const;
+	void Reset();
+
+private:
+	std::atomic<uint64> _hits{ 0 };
+	std::atomic<uint64> _misses{ 0 };
+};
+
 class MonitorAlert
 {
 public:
@@ -110,6 +134,8 @@ public:
 
 	// Flattened timediff upated every minute. This is a cached value.
 	uint32 GetSmoothTimeDiff() const { return smoothTD.Get(); }
+	// Line of sight cache hit rate (percent) of all maps during the last minute, -1 if unknown
+	int32 GetLineOfSightCacheHitRate() const { return _lastLoSCacheHitRate; }
 private:
 	// -- MapUpdater & World functions
 	void MapUpdateStart(Map const& map);
@@ -146,6 +172,10 @@ private:
 
 	MonitorAutoReboot _monitAutoReboot;
 	MonitorDynamicViewDistance _monitDynamicLoS;
+	MonitorAdaptiveTickRate _monitTickRate;
+	MonitorLineOfSightCache _monitLoSCache;
+	int32 _lastLoSCacheHitRate;
+	uint32 _losCacheTimer;
 	MonitorAlert      _monitAlert;
 
 	SmoothedTimeDiff smoothTD;
@@ -17,6 +17,8 @@
 
 #include "AbstractFollower.h"
 #include "Unit.h"
+#include "Util.h"
+#include "World.h"
 
 void AbstractFollower::SetTarget(Unit* unit)
 {
@@ -28,4 +30,20 @@ void AbstractFollower::SetTarget(Unit* unit)
     _target = unit;
     if (_target)
         _target->FollowerAdded(this);
-}
\ No newline at end of file
+}
+
+bool AbstractFollower::CanKeepMovingPath(Unit* owner, Position const& lastTargetPosition) const
+{
+    if (_repathTimer)
+        return true;
+
+    // is our path aimed too far from where the target now is? paths of far followers need less precision
+    float const tolerance = std::max(sWorld->GetRate(RATE_TARGET_POS_RECALCULATION_RANGE), owner->GetExactDist(_target) * sWorld->GetRate(RATE_TARGET_POS_RECALCULATION_RATIO));
+    return lastTargetPosition.GetExactDistSq(_target) <= square(tolerance);
+}
+
+void AbstractFollower::StartRepathTimer()
+{
+    uint32 const interval = sWorld->getIntConfig(CONFIG_TARGET_POS_RECALCULATION_INTERVAL);
+    _repathTimer = interval + urand(0, interval / 4);
+}
@@ -18,7 +18,10 @@
 #ifndef TRINITY_ABSTRACTFOLLOWER_H
 #define TRINITY_ABSTRACTFOLLOWER_H
 
+#include "Define.h"
+
 class Unit;
+struct Position;
 
 struct AbstractFollower
 {
@@ -29,8 +32,17 @@ public:
     void SetTarget(Unit* unit);
     Unit* GetTarget() const { return _target; }
 
+protected:
+    // While already moving, small target moves are caught up at most every TargetPosRecalculateInterval, once they get large compared to the distance left
+    bool CanKeepMovingPath(Unit* owner, Position const& lastTargetPosition) const;
+    void UpdateRepathTimer(uint32 diff) { _repathTimer = _repathTimer > diff ? _repathTimer - diff : 0; }
+    // A random part is added so that followers spread over updates
+    void StartRepathTimer();
+    void ResetRepathTimer() { _repathTimer = 0; }
+
 private:
     Unit * _target = nullptr;
+    uint32 _repathTimer = 0;
 };
 
 #endif
\ No newline at end of file
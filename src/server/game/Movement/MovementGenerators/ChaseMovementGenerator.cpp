@@ -71,6 +71,7 @@ bool ChaseMovementGenerator::Initialize(Unit* owner)
     AddFlag(MOVEMENTGENERATOR_FLAG_INITIALIZED);
 
     _lastTargetPosition.Relocate(0.0f, 0.0f, 0.0f);
+    ResetRepathTimer();
     owner->SetWalk(false);
     _path = nullptr;
     return true;
@@ -141,6 +142,13 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
         DoMovementInform(owner, target);
     }
 
+    UpdateRepathTimer(diff);
+
+    // if we're already moving, keep our path until the target moved far enough from where it is aimed
+    if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && mutualChase == _mutualChase
+        && CanKeepMovingPath(owner, _lastTargetPosition))
+        return true;
+
     // if the target moved, we have to consider whether to adjust
     if (_lastTargetPosition != target->GetPosition() || mutualChase != _mutualChase)
     {
@@ -216,6 +224,7 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
             init.SetFacing(target);
 
             init.Launch();
+            StartRepathTimer();
         }
     }
 
@@ -42,6 +42,7 @@ bool FollowMovementGenerator::Initialize(Unit* owner)
     UpdatePetSpeed(owner);
     _path = nullptr;
     _lastTargetPosition.Relocate(0.0f, 0.0f, 0.0f);
+    ResetRepathTimer();
     return true;
 }
 
@@ -93,6 +94,13 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         DoMovementInform(owner, target);
     }
 
+    UpdateRepathTimer(diff);
+
+    // if we're already moving, keep our path until the target moved far enough from where it is aimed
+    if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE)
+        && CanKeepMovingPath(owner, _lastTargetPosition))
+        return true;
+
     if (_lastTargetPosition.GetExactDistSq(target->GetPosition()) > 0.0f)
     {
         _lastTargetPosition = target->GetPosition();
@@ -150,6 +158,7 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
                         init.SetFacing(p->GetOrientation());
 
             init.Launch();
+            StartRepathTimer();
 
         }
     }
@@ -26,7 +26,7 @@ class FollowMovementGenerator : public MovementGenerator, public AbstractFollowe
 
         MovementGeneratorType GetMovementGeneratorType() const override { return FOLLOW_MOTION_TYPE; }
 
-        void UnitSpeedChanged() override { _lastTargetPosition.Relocate(0.0f, 0.0f, 0.0f); }
+        void UnitSpeedChanged() override { _lastTargetPosition.Relocate(0.0f, 0.0f, 0.0f); ResetRepathTimer(); }
 
     private:
         static constexpr uint32 CHECK_INTERVAL = 500;
@@ -17,6 +17,7 @@
  */
 
 #include "MoveSplineInit.h"
+#include "Map.h"
 #include "MoveSpline.h"
 #include "MovementPacketBuilder.h"
 #include "Unit.h"
@@ -70,7 +71,13 @@ namespace Movement
         }
 
         PacketBuilder::WriteMonsterMove(*(unit->movespline), data);
-        unit->SendMessageToSet(&data, true);
+
+        // chase and follow relaunch creature splines often, only the last one of a map update needs to be sent.
+        // Splines without travel time (facing) are given a 1 ms duration and sent right away, they are not relaunched
+        if (unit->GetTypeId() == TYPEID_UNIT && unit->IsInWorld() && unit->movespline->Duration() > 1)
+            unit->GetMap()->QueueMonsterMove(unit, unit->movespline->GetId(), std::move(data));
+        else
+            unit->SendMessageToSet(&data, true);
     }
 
     int32 MoveSplineInit::Launch()
@@ -177,6 +177,19 @@ ObjectGuid::LowType WorldSession::GetGUIDLow() const
 }
 
 void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (PrepareSendPacket(packet))
+        m_Socket->SendPacket(*packet);
+}
+
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (PrepareSendPacket(packet.get()))
+        m_Socket->SendPacket(packet);
+}
+
+/// Bot hooks, statistics and logs common to all sent packets, returns false if packet must not be sent to socket
+bool WorldSession::PrepareSendPacket(WorldPacket const* packet)
 {
     ASSERT(packet->GetOpcode() != NULL_OPCODE);
 
@@ -192,7 +205,7 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 #endif
 
     if (!m_Socket)
-        return;
+        return false;
 
 #ifdef TRINITY_DEBUG
 
@@ -233,11 +246,12 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     //    sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket->SendPacket(*packet);
 
     // Log packet for replay
     if (m_replayRecorder)
         m_replayRecorder->AddPacket(packet);
+
+    return true;
 }
 
 /// Add an incoming packet to the queue
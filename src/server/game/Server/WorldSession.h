@@ -217,6 +217,8 @@ class TC_GAME_API WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        // Send a packet built once for many sessions, payload is not copied per session
+        void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(int32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -934,6 +936,7 @@ class TC_GAME_API WorldSession
         bool CanUseBank(ObjectGuid bankerGUID = ObjectGuid::Empty) const;
 
         // logging helper
+        bool PrepareSendPacket(WorldPacket const* packet);
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
@@ -13,14 +13,16 @@
 #include <boost/asio/ip/tcp.hpp>
 #include "LogsDatabaseAccessor.h"
 
-class EncryptablePacket : public WorldPacket
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt) { }
+    EncryptablePacket(std::shared_ptr<WorldPacket const> const& packet, bool encrypt) : _packet(packet), _encrypt(encrypt) { }
 
+    WorldPacket const& GetPacket() const { return *_packet; }
     bool NeedsEncryption() const { return _encrypt; }
 
 private:
+    std::shared_ptr<WorldPacket const> _packet;     // shared with other sockets for broadcasts, only headers are encrypted
     bool _encrypt;
 };
 
@@ -89,28 +91,29 @@ bool WorldSocket::Update()
     MessageBuffer buffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
-        ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+        WorldPacket const& packet = queued->GetPacket();
+        ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
         if (_authCrypt && queued->NeedsEncryption())
             _authCrypt->EncryptSend(header.header, header.getHeaderLength());
 
-        if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+        if (buffer.GetRemainingSpace() < packet.size() + header.getHeaderLength())
         {
             QueuePacket(std::move(buffer));
             buffer.Resize(_sendBufferSize);
         }
 
-        if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+        if (buffer.GetRemainingSpace() >= packet.size() + header.getHeaderLength())
         {
             buffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                buffer.Write(queued->contents(), queued->size());
+            if (!packet.empty())
+                buffer.Write(packet.contents(), packet.size());
         }
         else    // single packet larger than 4096 bytes
         {
-            MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
+            MessageBuffer packetBuffer(packet.size() + header.getHeaderLength());
             packetBuffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                packetBuffer.Write(queued->contents(), queued->size());
+            if (!packet.empty())
+                packetBuffer.Write(packet.contents(), packet.size());
 
             QueuePacket(std::move(packetBuffer));
         }
@@ -422,6 +425,16 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (!IsOpen())
         return;
 
+    SendPacket(std::make_shared<WorldPacket const>(packet));
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& sharedPacket)
+{
+    if (!IsOpen())
+        return;
+
+    WorldPacket const& packet = *sharedPacket;
+
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
@@ -435,7 +448,7 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
             _lastPacketsSent.push_back(packet);
     }
 
-    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt && _authCrypt->IsInitialized()));
+    _bufferQueue.Enqueue(new EncryptablePacket(sharedPacket, _authCrypt && _authCrypt->IsInitialized()));
 }
 
 void WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
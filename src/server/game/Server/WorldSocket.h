@@ -45,6 +45,8 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    // Queue a packet without copying it, for packets sent to many sockets
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -22,6 +22,7 @@
 #include "SpellDefines.h"
 #include "Formulas.h"
 #include "ScriptMgr.h"
+#include "ObjectPool.h"
 #include <numeric>
 
 //
@@ -316,6 +317,16 @@ AuraEffect::AuraEffect(Aura* base, uint8 effIndex, int32 const* baseAmount, Unit
     CalculateSpellMod();
 }
 
+void* AuraEffect::operator new(size_t size)
+{
+    return ObjectPool<AuraEffect>::Allocate(size, "AuraEffect");
+}
+
+void AuraEffect::operator delete(void* ptr, size_t size)
+{
+    ObjectPool<AuraEffect>::Deallocate(ptr, size, "AuraEffect");
+}
+
 AuraEffect::~AuraEffect()
 {
     delete m_spellmod;
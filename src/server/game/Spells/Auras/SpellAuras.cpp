@@ -33,6 +33,7 @@
 #include "SpellScript.h"
 #include "ScriptMgr.h"
 #include "SpellHistory.h"
+#include "ObjectPool.h"
 
 AuraCreateInfo::AuraCreateInfo(SpellInfo const* spellInfo, uint8 auraEffMask, WorldObject* owner) :
     _spellInfo(spellInfo), _auraEffectMask(auraEffMask), _owner(owner)
@@ -111,6 +112,16 @@ void AuraApplication::_UpdateSlot()
 #endif
 }
 
+void* AuraApplication::operator new(size_t size)
+{
+    return ObjectPool<AuraApplication>::Allocate(size, "AuraApplication");
+}
+
+void AuraApplication::operator delete(void* ptr, size_t size)
+{
+    ObjectPool<AuraApplication>::Deallocate(ptr, size, "AuraApplication");
+}
+
 AuraApplication::AuraApplication(Unit* target, Unit* caster, Aura* aura, uint8 effMask) :
     _target(target), _base(aura), _removeMode(AURA_REMOVE_NONE), _slot(MAX_AURAS), _positive(false), _effectMask(0), _selfCast(false),
     _flags(AFLAG_NONE), _effectsToApply(effMask), _needClientUpdate(false), _durationChanged(true)
@@ -729,6 +740,19 @@ void Aura::_InitEffects(uint8 effMask, Unit* caster, int32 const* baseAmount)
     }
 }
 
+// one pool for all aura types, slots fit the biggest one
+typedef ObjectPool<Aura, std::max(sizeof(UnitAura), sizeof(DynObjAura))> AuraPool;
+
+void* Aura::operator new(size_t size)
+{
+    return AuraPool::Allocate(size, "Aura");
+}
+
+void Aura::operator delete(void* ptr, size_t size)
+{
+    AuraPool::Deallocate(ptr, size, "Aura");
+}
+
 Aura::~Aura()
 {
     delete m_channelData;
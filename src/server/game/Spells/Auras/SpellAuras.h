@@ -52,6 +52,10 @@ private:
     void _HandleEffect(uint8 effIndex, bool apply);
 
 public:
+    // allocated from ObjectPool
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
     Unit * GetTarget() const { return _target; }
     Aura* GetBase() const { return _base; }
 
@@ -120,6 +124,10 @@ public:
     void SaveCasterInfo(Unit* caster);
     virtual ~Aura();
 
+    // allocated from ObjectPool, for all aura types
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
     SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
     uint32 GetId() const;
     ObjectGuid GetCastItemGUID() const { return m_castItemGuid; }
@@ -37,6 +37,7 @@
 #include "SpellHistory.h"
 #include "SpellPackets.h"
 #include "TradeData.h"
+#include "ObjectPool.h"
 
 extern SpellEffectHandlerFn SpellEffectHandlers[TOTAL_SPELL_EFFECTS];
 
@@ -690,6 +691,16 @@ void Spell::RecalculateDelayMomentForDst()
     m_caster->m_Events.ModifyEventTime(_spellEvent, GetDelayStart() + m_delayMoment);
 }
 
+void* Spell::operator new(size_t size)
+{
+    return ObjectPool<Spell>::Allocate(size, "Spell");
+}
+
+void Spell::operator delete(void* ptr, size_t size)
+{
+    ObjectPool<Spell>::Deallocate(ptr, size, "Spell");
+}
+
 Spell::~Spell()
 {
     // unload scripts
@@ -1259,8 +1270,30 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
     if (uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList))
     {
         Trinity::WorldObjectSpellConeTargetCheck check(coneAngle, radius, m_caster, m_spellInfo, selectionType, condList);
-        Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-        SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
+        if (CanSearchInUnitSpatialIndex(containerTypeMask, m_caster))
+        {
+            // same shapes as WorldObjectSpellConeTargetCheck
+            std::vector<Unit*> units;
+            UnitSpatialIndex& index = m_caster->GetMap()->GetUnitSpatialIndex();
+            float const x = m_caster->GetPositionX();
+            float const y = m_caster->GetPositionY();
+            float const o = m_caster->GetOrientation();
+            if (m_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_BACK))
+                index.GetUnitsInArc(x, y, o + M_PI, coneAngle, radius, containerTypeMask, units);
+            else if (m_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_LINE))
+                index.GetUnitsInLine(x, y, o, radius, m_caster->GetCombatReach(), containerTypeMask, units);
+            else if (m_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_180))
+                index.GetUnitsInArc(x, y, o, M_PI, radius, containerTypeMask, units);
+            else
+                index.GetUnitsInArc(x, y, o, coneAngle, radius, containerTypeMask, units);
+
+            FilterIndexedUnits(units, check, targets);
+        }
+        else
+        {
+            Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
+            SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
+        }
 
         CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
 
@@ -1368,6 +1401,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Trinity::Containers::RandomResize(targets, maxTargets);
         }
 
+        PrefetchAreaTargetsLineOfSight(targets);
+
         for (auto & target : targets)
         {
             if (Unit* newTarget = target->ToUnit())
@@ -1963,6 +1998,27 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject*
     }
 }
 
+bool Spell::CanSearchInUnitSpatialIndex(uint32 containerMask, WorldObject* referer) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_SPELL_AREA_TARGET_INDEX))
+        return false;
+
+    // index only contains units
+    if (containerMask & ~(GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER))
+        return false;
+
+    return referer->GetMap() == m_caster->GetMap();
+}
+
+template<class CHECK>
+void Spell::FilterIndexedUnits(std::vector<Unit*> const& units, CHECK& check, std::list<WorldObject*>& targets)
+{
+    // index only returns candidates, the check still does the exact shape test on current positions
+    for (Unit* unit : units)
+        if (check(unit))
+            targets.push_back(unit);
+}
+
 WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
 {
     WorldObject* target = nullptr;
@@ -1981,6 +2037,14 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     if (!containerTypeMask)
         return;
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
+    if (CanSearchInUnitSpatialIndex(containerTypeMask, referer))
+    {
+        std::vector<Unit*> units;
+        referer->GetMap()->GetUnitSpatialIndex().GetUnitsInRange(position->GetPositionX(), position->GetPositionY(), range, containerTypeMask, units);
+        FilterIndexedUnits(units, check, targets);
+        return;
+    }
+
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> >(searcher, containerTypeMask, m_caster, position, range);
 }
@@ -7724,12 +7788,49 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
     return true;
 }
 
+void Spell::PrefetchAreaTargetsLineOfSight(std::list<WorldObject*> const& targets) const
+{
+    if (targets.size() < 4 || !sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL) || m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+        return;
+
+    // Only the target->IsWithinLOS(point) checks of CheckEffectTarget are prefetched, others still do a single check
+    Position const* point = nullptr;
+    if (m_targets.HasDst())
+        point = m_targets.GetDstPos();
+    else if (IsTriggered())
+        point = m_caster;
+
+    if (!point)
+        return;
+
+    Map const* map = m_caster->GetMap();
+    uint32 const phaseMask = m_caster->GetPhaseMask();
+    std::vector<VMAP::LineOfSightSegment> segments;
+    segments.reserve(targets.size());
+    for (WorldObject const* target : targets)
+        if (target->ToUnit() && target->GetPhaseMask() == phaseMask && target->IsInMap(m_caster))
+            segments.push_back(target->GetLineOfSightSegment(point->GetPositionX(), point->GetPositionY(), point->GetPositionZ()));
+
+    std::vector<bool> results;
+    map->isInLineOfSightMulti(segments, phaseMask, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing, results);
+}
+
 bool Spell::IsNeedSendToClient() const
 {
     return m_spellInfo->SpellVisual != 0 || m_spellInfo->IsChanneled() ||
         m_spellInfo->Speed > 0.0f || (!m_triggeredByAuraSpell && !IsTriggered());
 }
 
+void* SpellEvent::operator new(size_t size)
+{
+    return ObjectPool<SpellEvent>::Allocate(size, "SpellEvent");
+}
+
+void SpellEvent::operator delete(void* ptr, size_t size)
+{
+    ObjectPool<SpellEvent>::Deallocate(ptr, size, "SpellEvent");
+}
+
 SpellEvent::SpellEvent(Spell* spell) : BasicEvent()
 {
     m_Spell = spell;
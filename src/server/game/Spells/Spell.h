@@ -405,6 +405,10 @@ class TC_GAME_API Spell
         Spell(WorldObject* caster, SpellInfo const *info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, Spell** triggeringContainer = nullptr, bool skipCheck = false);
         ~Spell();
 
+        // allocated from ObjectPool
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
@@ -426,6 +430,9 @@ class TC_GAME_API Spell
 
         uint32 GetSearcherTypeMask(SpellTargetObjectTypes objType, ConditionContainer* condList);
         template<class SEARCHER> void SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject* referer, Position const* pos, float radius);
+        // Searches for units only can use the map UnitSpatialIndex instead of visiting grid cells
+        bool CanSearchInUnitSpatialIndex(uint32 containerMask, WorldObject* referer) const;
+        template<class CHECK> void FilterIndexedUnits(std::vector<Unit*> const& units, CHECK& check, std::list<WorldObject*>& targets);
 
         WorldObject* SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList = nullptr);
         void SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList);
@@ -485,6 +492,8 @@ class TC_GAME_API Spell
         void UpdateSpellCastDataAmmo(WorldPackets::Spells::SpellAmmo& ammo);
 
         bool CheckEffectTarget(Unit const* target, uint32 eff) const;
+        // Compute line of sight of area targets in one batch, CheckEffectTarget then finds the results in the map line of sight cache
+        void PrefetchAreaTargetsLineOfSight(std::list<WorldObject*> const& targets) const;
         void CheckSrc() { if(!m_targets.HasSrc()) m_targets.SetSrc(m_caster); }
         void CheckDst() { if(!m_targets.HasDst()) m_targets.SetDst(m_caster); }
 
@@ -871,6 +880,10 @@ class TC_GAME_API SpellEvent : public BasicEvent
         SpellEvent(Spell* spell);
         ~SpellEvent() override;
 
+        // allocated from ObjectPool
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         bool Execute(uint64 e_time, uint32 p_time) override;
         void Abort(uint64 e_time) override;
         bool IsDeletable() const override;
@@ -560,6 +560,13 @@ void World::LoadConfigSettings(bool reload)
         rate_values[RATE_TARGET_POS_RECALCULATION_RANGE] = NOMINAL_MELEE_RANGE;
     }
 
+    rate_values[RATE_TARGET_POS_RECALCULATION_RATIO] = sConfigMgr->GetFloatDefault("TargetPosRecalculateRatio", 0.15f);
+    if(rate_values[RATE_TARGET_POS_RECALCULATION_RATIO] < 0.0f)
+    {
+        TC_LOG_ERROR("server.loading","TargetPosRecalculateRatio (%f) must be >= 0. Using 0 instead.",rate_values[RATE_TARGET_POS_RECALCULATION_RATIO]);
+        rate_values[RATE_TARGET_POS_RECALCULATION_RATIO] = 0.0f;
+    }
+
     rate_values[RATE_DURABILITY_LOSS_DAMAGE] = sConfigMgr->GetFloatDefault("DurabilityLossChance.Damage",0.5f);
     if(rate_values[RATE_DURABILITY_LOSS_DAMAGE] < 0.0f)
     {
@@ -1069,6 +1076,7 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_CORPSE_DECAY_WORLDBOSS] = sConfigMgr->GetIntDefault("Corpse.Decay.WORLDBOSS", 3600);
 
     m_configs[CONFIG_DETECT_POS_COLLISION] = sConfigMgr->GetBoolDefault("DetectPosCollision", true);
+    m_configs[CONFIG_SPELL_AREA_TARGET_INDEX] = sConfigMgr->GetBoolDefault("Spell.AreaTargetIndex", true);
 
     m_configs[CONFIG_DEATH_SICKNESS_LEVEL] = sConfigMgr->GetIntDefault("Death.SicknessLevel", 11);
     m_configs[CONFIG_DEATH_CORPSE_RECLAIM_DELAY_PVP] = sConfigMgr->GetBoolDefault("Death.CorpseReclaimDelay.PvP", true);
@@ -1101,6 +1109,7 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_INSTANT_LOGOUT] = sConfigMgr->GetIntDefault("InstantLogout", SEC_GAMEMASTER1);
 
     m_configs[CONFIG_GROUPLEADER_RECONNECT_PERIOD] = sConfigMgr->GetIntDefault("GroupLeaderReconnectPeriod", 180);
+    m_configs[CONFIG_GROUP_MEMBER_STATS_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("GroupMemberStatsUpdateInterval", 500);
 
     //visibility on continents
     m_MaxVisibleDistanceOnContinents      = sConfigMgr->GetFloatDefault("Visibility.Distance.Continents",     DEFAULT_VISIBILITY_DISTANCE);
@@ -1186,6 +1195,19 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     TC_LOG_INFO("server.loading", "WORLD: VMap support included. LineOfSight:%i, getHeight:%i",enableLOS, enableHeight);
     TC_LOG_INFO("server.loading", "WORLD: VMap data directory is: %svmaps",m_dataPath.c_str());
+    m_configs[CONFIG_LOS_CACHE_TTL] = sConfigMgr->GetIntDefault("vmap.LineOfSightCacheTTL", 500);
+    if (m_configs[CONFIG_LOS_CACHE_TTL] > 5000)
+    {
+        TC_LOG_ERROR("server.loading", "vmap.LineOfSightCacheTTL (%u) must be <= 5000. Using 5000 instead.", m_configs[CONFIG_LOS_CACHE_TTL]);
+        m_configs[CONFIG_LOS_CACHE_TTL] = 5000;
+    }
+
+    m_configs[CONFIG_TARGET_POS_RECALCULATION_INTERVAL] = sConfigMgr->GetIntDefault("TargetPosRecalculateInterval", 250);
+    if (m_configs[CONFIG_TARGET_POS_RECALCULATION_INTERVAL] < 0)
+    {
+        TC_LOG_ERROR("server.loading", "TargetPosRecalculateInterval (%i) must be >= 0. Using 0 instead.", m_configs[CONFIG_TARGET_POS_RECALCULATION_INTERVAL]);
+        m_configs[CONFIG_TARGET_POS_RECALCULATION_INTERVAL] = 0;
+    }
 
     m_configs[CONFIG_PREMATURE_BG_REWARD] = sConfigMgr->GetBoolDefault("Battleground.PrematureReward", true);
     m_configs[CONFIG_START_ALL_EXPLORED] = sConfigMgr->GetBoolDefault("PlayerStart.MapsExplored", false);
@@ -1203,6 +1225,7 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 10);
     m_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 4);
+    m_configs[CONFIG_MAP_PARALLEL_DELAYED_UPDATE] = sConfigMgr->GetBoolDefault("MapUpdate.ParallelDelayedUpdate", true);
 
     m_configs[CONFIG_WORLDCHANNEL_MINLEVEL] = sConfigMgr->GetIntDefault("WorldChannel.MinLevel", 10);
 
@@ -1244,6 +1267,14 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Monitor.DynamicViewDist.AverageCount must be greater than 0. Setting it to default value (500)");
         m_configs[CONFIG_MONITORING_DYNAMIC_VIEWDIST_AVERAGE_COUNT] = 500;
     }
+    m_configs[CONFIG_MONITORING_ADAPTIVE_TICKRATE] = sConfigMgr->GetBoolDefault("Monitor.AdaptiveTickRate.Enable", 0);
+    m_configs[CONFIG_MONITORING_ADAPTIVE_TICKRATE_IDLE_INTERVAL] = sConfigMgr->GetIntDefault("Monitor.AdaptiveTickRate.IdleInterval", 1000);
+    if (m_configs[CONFIG_MONITORING_ADAPTIVE_TICKRATE_IDLE_INTERVAL] > 10000)
+    {
+        TC_LOG_ERROR("server.loading", "Monitor.AdaptiveTickRate.IdleInterval must be lower than 10000. Setting it to default value (1000)");
+        m_configs[CONFIG_MONITORING_ADAPTIVE_TICKRATE_IDLE_INTERVAL] = 1000;
+    }
+    m_configs[CONFIG_MONITORING_ADAPTIVE_TICKRATE_MAX_COST] = sConfigMgr->GetIntDefault("Monitor.AdaptiveTickRate.MaxCost", 20);
 
 
     std::string forbiddenmaps = sConfigMgr->GetStringDefault("ForbiddenMaps", "");
@@ -1414,7 +1445,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     TC_LOG_INFO("server.loading","Initialize data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, sConfigMgr->GetStringDefault("DBC.CacheFile", ""));
     DetectDBCLang();
 
     // Load cinematic cameras
@@ -1560,6 +1591,10 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading instance spawn groups...");
     sObjectMgr->LoadInstanceSpawnGroups();
 
+    std::string spawnSnapshotFile = sConfigMgr->GetStringDefault("SpawnSnapshotFile", "");
+    if (!spawnSnapshotFile.empty() && !getConfig(CONFIG_DEBUG_DISABLE_CREATURES_LOADING) && !getConfig(CONFIG_DEBUG_DISABLE_GAMEOBJECTS_LOADING))
+        sObjectMgr->OpenSpawnSnapshot(m_dataPath + spawnSnapshotFile);
+
     if(!getConfig(CONFIG_DEBUG_DISABLE_CREATURES_LOADING))
     {
         TC_LOG_INFO("server.loading", "Loading Creature Data..." );
@@ -1578,6 +1613,8 @@ void World::SetInitialWorldSettings()
         sObjectMgr->LoadGameObjects();
     }
 
+    sObjectMgr->CloseSpawnSnapshot();
+
     TC_LOG_INFO("server.loading", "Loading Spawn Group Data...");
     sObjectMgr->LoadSpawnGroups();
 
@@ -195,6 +195,7 @@ enum WorldConfigs
     CONFIG_RESPAWN_DYNAMICRATE_GAMEOBJECT,
 
     CONFIG_DETECT_POS_COLLISION,
+    CONFIG_SPELL_AREA_TARGET_INDEX,
     CONFIG_CHAT_FAKE_MESSAGE_PREVENTING,
     CONFIG_CORPSE_DECAY_NORMAL,
     CONFIG_CORPSE_DECAY_RARE,
@@ -210,6 +211,7 @@ enum WorldConfigs
     CONFIG_THREAT_RADIUS,
     CONFIG_INSTANT_LOGOUT,
     CONFIG_GROUPLEADER_RECONNECT_PERIOD,
+    CONFIG_GROUP_MEMBER_STATS_UPDATE_INTERVAL,
     CONFIG_ALL_TAXI_PATHS,
     CONFIG_INSTANT_TAXI,
     CONFIG_DECLINED_NAMES_USED,
@@ -243,6 +245,9 @@ enum WorldConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PREMATURE_BG_REWARD,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_PARALLEL_DELAYED_UPDATE,
+    CONFIG_LOS_CACHE_TTL,
+    CONFIG_TARGET_POS_RECALCULATION_INTERVAL,
 
     CONFIG_WORLDCHANNEL_MINLEVEL,
 
@@ -362,6 +367,9 @@ enum WorldConfigs
     CONFIG_MONITORING_DYNAMIC_VIEWDIST_TRIGGER_DIFF,
     CONFIG_MONITORING_DYNAMIC_VIEWDIST_CHECK_INTERVAL,
     CONFIG_MONITORING_DYNAMIC_VIEWDIST_AVERAGE_COUNT,
+    CONFIG_MONITORING_ADAPTIVE_TICKRATE,
+    CONFIG_MONITORING_ADAPTIVE_TICKRATE_IDLE_INTERVAL,
+    CONFIG_MONITORING_ADAPTIVE_TICKRATE_MAX_COST,
 
 	CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT,
 
@@ -416,6 +424,7 @@ enum Rates
     RATE_CORPSE_DECAY_LOOTED,
     RATE_INSTANCE_RESET_TIME,
     RATE_TARGET_POS_RECALCULATION_RANGE,
+    RATE_TARGET_POS_RECALCULATION_RATIO,
     RATE_DURABILITY_LOSS_DAMAGE,
     RATE_DURABILITY_LOSS_PARRY,
     RATE_DURABILITY_LOSS_ABSORB,
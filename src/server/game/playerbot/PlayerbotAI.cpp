@@ -1097,7 +1097,7 @@ bool PlayerbotAI::HasAuraToDispel(Unit* target, uint32 dispelType)
     for (uint32 type = SPELL_AURA_NONE; type < TOTAL_AURAS; ++type)
     {
         auto const& auras = target->GetAuraEffectsByType((AuraType)type);
-        for (std::list<AuraEffect*>::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+        for (Unit::AuraEffectList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
         {
             const Aura* const aura = (*itr)->GetBase();
             const SpellInfo* entry = aura->GetSpellInfo();
@@ -1419,6 +1419,26 @@ void PlayerbotTestingAI::UpdateAIInternal(uint32 elapsed)
     */
 }
 
+void PlayerbotTestingAI::HandleBotOutgoingPacket(const WorldPacket& packet)
+{
+    switch (packet.GetOpcode())
+    {
+    case SMSG_MONSTER_MOVE:
+    case SMSG_MONSTER_MOVE_TRANSPORT:
+        {
+            WorldPacket p(packet);
+            ObjectGuid guid;
+            p >> guid.ReadAsPacked();
+            monsterMovesReceived[guid]++;
+            break;
+        }
+    default:
+        break;
+    }
+
+    PlayerbotAI::HandleBotOutgoingPacket(packet);
+}
+
 void PlayerbotTestingAI::CastedDamageSpell(Unit const* target, SpellNonMeleeDamage damageInfo, SpellMissInfo missInfo, bool crit) const
 {
     SpellDamageDoneInfo info(damageInfo.SpellID, damageInfo, missInfo, crit);
@@ -1504,6 +1524,15 @@ std::vector<PlayerbotTestingAI::HealingDoneInfo> const* PlayerbotTestingAI::GetH
     return &(*infoForVictimItr).second;
 }
 
+uint32 PlayerbotTestingAI::GetMonsterMoveCount(Unit const* mover) const
+{
+    auto itr = monsterMovesReceived.find(mover->GetGUID());
+    if (itr == monsterMovesReceived.end())
+        return 0;
+
+    return itr->second;
+}
+
 void PlayerbotTestingAI::ResetSpellCounters()
 {
     TC_LOG_TRACE("test.unit_test", "PlayerbotTestingAI: Counters were reset");
@@ -112,7 +112,7 @@ public:
     void UpdateAIInternal(uint32 elapsed) override;
     string HandleRemoteCommand(std::string command);
     void HandleCommand(uint32 type, const std::string& text, Player& fromPlayer);
-    void HandleBotOutgoingPacket(const WorldPacket& packet);
+    virtual void HandleBotOutgoingPacket(const WorldPacket& packet);
     void HandleMasterIncomingPacket(const WorldPacket& packet);
     void HandleMasterOutgoingPacket(const WorldPacket& packet);
     void HandleTeleportAck();
@@ -203,6 +203,7 @@ public:
     virtual ~PlayerbotTestingAI() {}
 
     void UpdateAIInternal(uint32 elapsed) override;
+    void HandleBotOutgoingPacket(const WorldPacket& packet) override;
     virtual void CastedDamageSpell(Unit const* target, SpellNonMeleeDamage damageInfo, SpellMissInfo missInfo, bool crit) const override;
     virtual void CastedHealingSpell(Unit const* target, uint32 healing, uint32 realGain, uint32 spellID, SpellMissInfo missInfo, bool crit) const override;
     virtual void PeriodicTick(Unit const* target, int32 amount, uint32 spellID) const override;
@@ -255,6 +256,9 @@ public:
     std::vector<HealingDoneInfo> const* GetHealingDoneInfo(Unit const* target) const;
     //Return main and offhand damages for this caster on given target. Does NOT includes ranged damage, those are in GetSpellDamageDoneInfo
     std::vector<MeleeDamageDoneInfo> const* GetMeleeDamageDoneInfo(Unit const* target) const;
+    //Get how many monster move packets this player received for given unit
+    uint32 GetMonsterMoveCount(Unit const* mover) const;
+    void ResetMonsterMoveCounters() { monsterMovesReceived.clear(); }
 
 private:
    
@@ -262,6 +266,7 @@ private:
     mutable std::unordered_map<ObjectGuid /*targetGUID*/, std::vector<MeleeDamageDoneInfo>> meleeDamageDone;
     mutable std::unordered_map<ObjectGuid /*targetGUID*/, std::vector<HealingDoneInfo>> healingDone;
     mutable std::unordered_map<ObjectGuid /*targetGUID*/, std::vector<TickInfo>> ticksDone;
+    std::unordered_map<ObjectGuid /*moverGUID*/, uint32> monsterMovesReceived;
 
 };
 
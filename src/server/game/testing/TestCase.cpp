@@ -1155,20 +1155,22 @@ void TestCase::_StartUnitChannels(Unit* unit)
 void TestCase::HandleSpellsCleanup(Unit* caster)
 {
     //Spell deletions are done in SpellEvent
-    EventList& eventList = caster->m_Events.m_events;
-    for (auto itr = eventList.begin(); itr != eventList.end();)
+    std::vector<SpellEvent*> finishedEvents;
+    caster->m_Events.RemoveEventsIf([&](BasicEvent* event)
     {
-        if (SpellEvent* spellEvent = dynamic_cast<SpellEvent*>(itr->second))
+        if (SpellEvent* spellEvent = dynamic_cast<SpellEvent*>(event))
             if (spellEvent->m_Spell->getState() == SPELL_STATE_FINISHED && spellEvent->m_Spell->IsDeletable())
             {
-                //what we're doing here is mimicing the EventProcessor::Update + SpellEvent::Execute behavior in this case, that is -> just delete the event.
-                itr = eventList.erase(itr);
-                delete spellEvent; //SpellEvent deletion handle spell deletion
-                continue;
+                finishedEvents.push_back(spellEvent);
+                return true;
             }
 
-        itr++;
-    }
+        return false;
+    });
+
+    //what we're doing here is mimicing the EventProcessor::Update + SpellEvent::Execute behavior in this case, that is -> just delete the event.
+    for (SpellEvent* spellEvent : finishedEvents)
+        delete spellEvent; //SpellEvent deletion handle spell deletion
 }
 
 void TestCase::_MaxHealth(Unit* unit, bool lowHealth /*= false*/)
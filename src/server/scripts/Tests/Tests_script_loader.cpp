@@ -21,12 +21,20 @@ void AddSC_test_talents_shaman();
 void AddSC_test_talents_warlock();
 void AddSC_test_talents_warrior();
 void AddSC_test_creature();
+void AddSC_test_maps();
+void AddSC_test_event_processor();
+void AddSC_test_object_accessor();
+void AddSC_test_threat();
 
 void AddTestsScripts()
 {
     AddSC_test_dummy();
     AddSC_test_loot_chance();
     AddSC_test_creature();
+    AddSC_test_maps();
+    AddSC_test_event_processor();
+    AddSC_test_object_accessor();
+    AddSC_test_threat();
 
 	AddSC_test_spells_druid();
 	AddSC_test_spells_hunter();
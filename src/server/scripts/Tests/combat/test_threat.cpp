@@ -0,0 +1,86 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "ThreatManager.h"
+#include "Timer.h"
+
+// Models a raid fight: 25 healers threatening 60 mobs through heals while tank keeps aggro, each mob selecting its victim every update
+class ThreatHealersBenchmark : public TestCaseScript
+{
+public:
+    ThreatHealersBenchmark() : TestCaseScript("combat threat_healers_benchmark") { }
+
+    class ThreatHealersBenchmarkImpl : public TestCase
+    {
+    public:
+        ThreatHealersBenchmarkImpl() : TestCase(STATUS_PASSING, WorldLocation(0, -8833.38f, 628.62f, 94.0f)) { }
+
+        void Test() override
+        {
+            uint32 const healerCount = 25;
+            uint32 const mobCount = 60;
+            uint32 const rounds = 2000;
+
+            TestPlayer* tank = SpawnRandomPlayer(CLASS_WARRIOR);
+            std::vector<TestPlayer*> healers;
+            for (uint32 i = 0; i < healerCount; i++)
+                healers.push_back(SpawnRandomPlayer(CLASS_PRIEST));
+
+            std::vector<Creature*> mobs;
+            for (uint32 i = 0; i < mobCount; i++)
+            {
+                Creature* mob = SpawnCreature();
+                mob->GetThreatManager().AddThreat(tank, 100000000.0f);
+                for (TestPlayer* healer : healers)
+                    mob->GetThreatManager().AddThreat(healer, 0.0f);
+                mobs.push_back(mob);
+            }
+
+            uint32 wrongVictims = 0;
+            uint32 const startTime = GetMSTime();
+            for (uint32 round = 0; round < rounds; round++)
+            {
+                // every healer heals the tank, threat is split between all mobs
+                for (uint32 i = 0; i < healerCount; i++)
+                    tank->GetThreatManager().ForwardThreatForAssistingMe(healers[i], float(1000 + (round * 7 + i * 13) % 2000) * 0.5f);
+
+                for (Creature* mob : mobs)
+                    if (mob->GetThreatManager().SelectVictim() != tank)
+                        wrongVictims++;
+            }
+            uint32 const elapsed = GetMSTimeDiffToNow(startTime);
+
+            ASSERT_INFO("%u victim selections did not return the tank", wrongVictims);
+            TEST_ASSERT(wrongVictims == 0);
+
+            for (Creature* mob : mobs)
+            {
+                ThreatReference const* previous = nullptr;
+                uint32 count = 0;
+                for (ThreatReference const* ref : mob->GetThreatManager().GetSortedThreatList())
+                {
+                    if (previous && previous->GetOnlineState() == ref->GetOnlineState() && previous->GetTauntState() == ref->GetTauntState())
+                    {
+                        ASSERT_INFO("Sorted threat list of %s is out of order: %f before %f", mob->GetGUID().ToString().c_str(), previous->GetThreat(), ref->GetThreat());
+                        TEST_ASSERT(previous->GetThreat() >= ref->GetThreat());
+                    }
+                    previous = ref;
+                    count++;
+                }
+                ASSERT_INFO("Sorted threat list has %u entries instead of %u", count, healerCount + 1);
+                TEST_ASSERT(count == healerCount + 1);
+            }
+
+            TC_LOG_INFO("test.unit_test", "Threat: %u healers x %u mobs, %u rounds of heals and victim selection in %u ms", healerCount, mobCount, rounds, elapsed);
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<ThreatHealersBenchmarkImpl>();
+    }
+};
+
+void AddSC_test_threat()
+{
+    new ThreatHealersBenchmark();
+}
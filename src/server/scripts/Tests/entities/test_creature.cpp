@@ -1,6 +1,7 @@
 #include "TestCase.h"
 #include "TestPlayer.h"
 #include "ObjectMgr.h"
+#include "MoveSplineInit.h"
 
 class CreatureLinkedRespawnTest : public TestCaseScript
 {
@@ -87,7 +88,81 @@ public:
     }
 };
 
+// Monster moves of creatures are queued until the end of the map update, check that players still receive them
+class CreatureMonsterMoveTest : public TestCaseScript
+{
+public:
+    CreatureMonsterMoveTest() : TestCaseScript("creature monster_move") { }
+
+    class CreatureMonsterMoveTestImpl : public TestCase
+    {
+    public:
+        CreatureMonsterMoveTestImpl() : TestCase(STATUS_PASSING, WorldLocation(0, -8833.38f, 628.62f, 94.0f)) { }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+            Creature* creature = SpawnCreature();
+            WaitNextUpdate();
+
+            ASSERT_INFO("Player does not see creature");
+            TEST_ASSERT(player->HaveAtClient(creature));
+
+            PlayerbotTestingAI* AI = player->GetTestingPlayerbotAI();
+            TEST_ASSERT(AI != nullptr);
+
+            auto checkMonsterMoves = [&](uint32 expected)
+            {
+                uint32 const count = AI->GetMonsterMoveCount(creature);
+                ASSERT_INFO("Player received %u monster moves instead of %u", count, expected);
+                TEST_ASSERT(count == expected);
+                AI->ResetMonsterMoveCounters();
+            };
+
+            AI->ResetMonsterMoveCounters();
+
+            SECTION("Facing", [&] {
+                // facing spline is finalized at next creature update, before queued moves are sent
+                creature->SetFacingToObject(player);
+                WaitNextUpdate();
+                checkMonsterMoves(1);
+            });
+
+            SECTION("Short move", [&] {
+                // spline ends during the update, its queued launch must still be sent
+                Movement::MoveSplineInit init(creature);
+                init.MoveTo(creature->GetPositionX() + 0.1f, creature->GetPositionY(), creature->GetPositionZ());
+                init.Launch();
+                Wait(100);
+                TEST_ASSERT(creature->movespline->Finalized());
+                checkMonsterMoves(1);
+            });
+
+            SECTION("Relaunch", [&] {
+                // only the last of several launches in the same update is sent
+                for (uint32 i = 0; i < 3; i++)
+                {
+                    Movement::MoveSplineInit init(creature);
+                    init.MoveTo(creature->GetPositionX() + 5.0f * (i + 1), creature->GetPositionY(), creature->GetPositionZ());
+                    init.Launch();
+                }
+                WaitNextUpdate();
+                checkMonsterMoves(1);
+                creature->StopMoving();
+                WaitNextUpdate();
+                AI->ResetMonsterMoveCounters();
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<CreatureMonsterMoveTestImpl>();
+    }
+};
+
 void AddSC_test_creature()
 {
     new CreatureLinkedRespawnTest();
+    new CreatureMonsterMoveTest();
 }
@@ -0,0 +1,484 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "Map.h"
+#include "ModelIgnoreFlags.h"
+#include "VMapFactory.h"
+#include "RespawnQueue.h"
+#include <boost/heap/fibonacci_heap.hpp>
+
+class UnitSpatialIndexTest : public TestCaseScript
+{
+public:
+    UnitSpatialIndexTest() : TestCaseScript("maps unit_spatial_index") { }
+
+    class UnitSpatialIndexTestImpl : public TestCase
+    {
+    public:
+        UnitSpatialIndexTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // index may return a few more units than requested, but never less
+        void TestRange(std::vector<Creature*> const& creatures, Position const& center, float radius)
+        {
+            std::vector<Unit*> found;
+            GetMap()->GetUnitSpatialIndex().GetUnitsInRange(center.GetPositionX(), center.GetPositionY(), radius, GRID_MAP_TYPE_MASK_CREATURE, found);
+            for (Creature* creature : creatures)
+            {
+                if (!creature->IsWithinDist2d(&center, radius))
+                    continue;
+
+                ASSERT_INFO("Creature at %f %f not found in range %f of %f %f", creature->GetPositionX(), creature->GetPositionY(), radius, center.GetPositionX(), center.GetPositionY());
+                TEST_ASSERT(std::find(found.begin(), found.end(), creature) != found.end());
+            }
+        }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+            Position const center = player->GetPosition();
+
+            std::vector<Creature*> creatures;
+            for (uint32 i = 0; i < 30; i++)
+            {
+                Position pos(center);
+                pos.m_positionX += frand(-60.0f, 60.0f);
+                pos.m_positionY += frand(-60.0f, 60.0f);
+                creatures.push_back(SpawnCreatureWithPosition(pos));
+            }
+            Wait(Seconds(1));
+
+            for (float radius : { 5.0f, 15.0f, 30.0f, 100.0f })
+                TestRange(creatures, center, radius);
+
+            ASSERT_INFO("Player should be found by a player search");
+            std::vector<Unit*> found;
+            GetMap()->GetUnitSpatialIndex().GetUnitsInRange(center.GetPositionX(), center.GetPositionY(), 5.0f, GRID_MAP_TYPE_MASK_PLAYER, found);
+            TEST_ASSERT(std::find(found.begin(), found.end(), player) != found.end());
+
+            SECTION("Relocation", [&] {
+                // move a creature far from its bucket
+                Creature* moved = creatures.front();
+                moved->NearTeleportTo(center.GetPositionX() + 150.0f, center.GetPositionY(), center.GetPositionZ(), 0.0f);
+                WaitNextUpdate();
+                Position const farCenter(center.GetPositionX() + 150.0f, center.GetPositionY(), center.GetPositionZ());
+                TestRange(creatures, farCenter, 10.0f);
+            });
+
+            SECTION("Removal", [&] {
+                Creature* removed = creatures.back();
+                creatures.pop_back();
+                removed->DespawnOrUnsummon();
+                WaitNextUpdate();
+                std::vector<Unit*> found;
+                GetMap()->GetUnitSpatialIndex().GetUnitsInRange(center.GetPositionX(), center.GetPositionY(), 100.0f, GRID_MAP_TYPE_MASK_CREATURE, found);
+                TEST_ASSERT(std::find(found.begin(), found.end(), removed) == found.end());
+                TestRange(creatures, center, 100.0f);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<UnitSpatialIndexTestImpl>();
+    }
+};
+
+class LineOfSightCacheTest : public TestCaseScript
+{
+public:
+    LineOfSightCacheTest() : TestCaseScript("maps los_cache") { }
+
+    class LineOfSightCacheTestImpl : public TestCase
+    {
+    public:
+        LineOfSightCacheTestImpl() : TestCase(STATUS_PASSING) { }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+            LineOfSightCache& cache = GetMap()->GetLineOfSightCache();
+            bool result = true;
+
+            cache.Set(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+            TEST_ASSERT(cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            TEST_ASSERT(result == false);
+
+            // quantized endpoints
+            TEST_ASSERT(cache.Get(10.05f, 10.0f, 10.0f, 20.0f, 20.05f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            TEST_ASSERT(!cache.Get(12.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            TEST_ASSERT(!cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_CHECK_VMAP, result));
+            TEST_ASSERT(!cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, 0x2, LINEOFSIGHT_ALL_CHECKS, result));
+
+            SECTION("Invalidate", [&] {
+                GetMap()->InvalidateLineOfSightCache();
+                TEST_ASSERT(!cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            });
+
+            SECTION("Area invalidation", [&] {
+                cache.Set(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+                cache.Set(1000.0f, 1000.0f, 10.0f, 1010.0f, 1010.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+                cache.Invalidate(0.0f, 0.0f, 15.0f, 15.0f);
+                TEST_ASSERT(!cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+                TEST_ASSERT(cache.Get(1000.0f, 1000.0f, 10.0f, 1010.0f, 1010.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+
+                // set after invalidation
+                cache.Set(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+                TEST_ASSERT(cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            });
+
+            // A transport moving every update removes its model from the map at its old position and inserts it at the new one (GameObject::UpdateModelPosition)
+            SECTION("Moving transport", [&] {
+                Position const pos = player->GetPosition();
+                G3D::Vector3 const halfSize(30.0f, 10.0f, 10.0f); // boat sized
+                G3D::Vector3 transportPos(pos.GetPositionX() - 500.0f, pos.GetPositionY() + 100.0f, pos.GetPositionZ());
+
+                // along the transport path, and far from it
+                cache.Set(pos.GetPositionX(), pos.GetPositionY() + 95.0f, pos.GetPositionZ(), pos.GetPositionX() + 10.0f, pos.GetPositionY() + 105.0f, pos.GetPositionZ(), PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+                cache.Set(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), pos.GetPositionX() + 10.0f, pos.GetPositionY() + 10.0f, pos.GetPositionZ(), PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+
+                uint32 farHits = 0;
+                for (uint32 i = 0; i < 200; i++)
+                {
+                    GetMap()->InvalidateLineOfSightCache(G3D::AABox(transportPos - halfSize, transportPos + halfSize));
+                    transportPos.x += 5.0f;
+                    GetMap()->InvalidateLineOfSightCache(G3D::AABox(transportPos - halfSize, transportPos + halfSize));
+
+                    if (cache.Get(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), pos.GetPositionX() + 10.0f, pos.GetPositionY() + 10.0f, pos.GetPositionZ(), PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result))
+                        farHits++;
+                }
+
+                ASSERT_INFO("Entry away from the transport path was dropped, only hit %u times out of 200", farHits);
+                TEST_ASSERT(farHits == 200);
+                TEST_ASSERT(!cache.Get(pos.GetPositionX(), pos.GetPositionY() + 95.0f, pos.GetPositionZ(), pos.GetPositionX() + 10.0f, pos.GetPositionY() + 105.0f, pos.GetPositionZ(), PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            });
+
+            SECTION("Expiration", [&] {
+                cache.Set(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, false);
+                Wait(sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL) + 500);
+                TEST_ASSERT(!cache.Get(10.0f, 10.0f, 10.0f, 20.0f, 20.0f, 20.0f, PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, result));
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<LineOfSightCacheTestImpl>();
+    }
+};
+
+// Batched line of sight must give the same results as one by one checks
+class VMapLineOfSightMultiTest : public TestCaseScript
+{
+public:
+    VMapLineOfSightMultiTest() : TestCaseScript("maps vmap_los_multi") { }
+
+    class VMapLineOfSightMultiTestImpl : public TestCase
+    {
+    public:
+        VMapLineOfSightMultiTestImpl() : TestCase(STATUS_PASSING, WorldLocation(0, -8833.38f, 628.62f, 94.0f)) { }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+            Position const center = player->GetPosition();
+            Wait(Seconds(1));
+
+            VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+            uint32 singleTime = 0;
+            uint32 multiTime = 0;
+            uint32 blocked = 0;
+            for (uint32 batch = 0; batch < 200; batch++)
+            {
+                std::vector<VMAP::LineOfSightSegment> segments;
+                for (uint32 i = 0; i < 25; i++)
+                    segments.push_back({ center.GetPositionX(), center.GetPositionY(), center.GetPositionZ() + 2.0f,
+                        center.GetPositionX() + frand(-40.0f, 40.0f), center.GetPositionY() + frand(-40.0f, 40.0f), center.GetPositionZ() + frand(-5.0f, 10.0f) });
+
+                uint32 startTime = GetMSTime();
+                std::vector<bool> results(segments.size(), true);
+                vmgr->isInLineOfSightMulti(GetMap()->GetId(), segments, VMAP::ModelIgnoreFlags::Nothing, results);
+                multiTime += GetMSTimeDiffToNow(startTime);
+
+                startTime = GetMSTime();
+                for (uint32 i = 0; i < segments.size(); i++)
+                {
+                    VMAP::LineOfSightSegment const& segment = segments[i];
+                    bool const single = vmgr->isInLineOfSight(GetMap()->GetId(), segment.x1, segment.y1, segment.z1, segment.x2, segment.y2, segment.z2, VMAP::ModelIgnoreFlags::Nothing);
+                    ASSERT_INFO("Segment to %f %f %f: single check %u, batch %u", segment.x2, segment.y2, segment.z2, uint32(single), uint32(results[i]));
+                    TEST_ASSERT(single == results[i]);
+                    if (!single)
+                        blocked++;
+                }
+                singleTime += GetMSTimeDiffToNow(startTime);
+            }
+            TC_LOG_INFO("test.unit_test", "VMap LoS: 200 batches of 25 segments (%u blocked), batched %u ms, one by one %u ms", blocked, multiTime, singleTime);
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<VMapLineOfSightMultiTestImpl>();
+    }
+};
+
+// Not a correctness test, times line of sight checks against the vmaps of Stormwind (lots of wmo geometry)
+class VMapLineOfSightBenchmark : public TestCaseScript
+{
+public:
+    VMapLineOfSightBenchmark() : TestCaseScript("maps vmap_los_benchmark") { }
+
+    class VMapLineOfSightBenchmarkImpl : public TestCase
+    {
+    public:
+        VMapLineOfSightBenchmarkImpl() : TestCase(STATUS_PASSING, WorldLocation(0, -8833.38f, 628.62f, 94.0f)) { }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+            Position const center = player->GetPosition();
+            Wait(Seconds(1));
+
+            uint32 const checkCount = 20000;
+            std::vector<Position> points;
+            points.reserve(checkCount * 2);
+            for (uint32 i = 0; i < checkCount * 2; i++)
+                points.emplace_back(center.GetPositionX() + frand(-80.0f, 80.0f), center.GetPositionY() + frand(-80.0f, 80.0f), center.GetPositionZ() + frand(-5.0f, 20.0f));
+
+            uint32 blocked = 0;
+            uint32 const startTime = GetMSTime();
+            for (uint32 i = 0; i < checkCount; i++)
+            {
+                Position const& from = points[i * 2];
+                Position const& to = points[i * 2 + 1];
+                if (!GetMap()->isInLineOfSight(from.GetPositionX(), from.GetPositionY(), from.GetPositionZ(), to.GetPositionX(), to.GetPositionY(), to.GetPositionZ(), PHASEMASK_NORMAL, LINEOFSIGHT_CHECK_VMAP, VMAP::ModelIgnoreFlags::Nothing))
+                    blocked++;
+            }
+            TC_LOG_INFO("test.unit_test", "VMap LoS benchmark: %u checks (%u blocked) in %u ms", checkCount, blocked, GetMSTimeDiffToNow(startTime));
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<VMapLineOfSightBenchmarkImpl>();
+    }
+};
+
+// Batched terrain heights must be the same as one by one, also times both
+class GridMapHeightBenchmark : public TestCaseScript
+{
+public:
+    GridMapHeightBenchmark() : TestCaseScript("maps grid_height_benchmark") { }
+
+    class GridMapHeightBenchmarkImpl : public TestCase
+    {
+    public:
+        GridMapHeightBenchmarkImpl() : TestCase(STATUS_PASSING, WorldLocation(0, -8833.38f, 628.62f, 94.0f)) { }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+            Position const center = player->GetPosition();
+            Wait(Seconds(1));
+
+            // spline like paths, successive points close to each other
+            uint32 const pointCount = 200000;
+            std::vector<float> x(pointCount);
+            std::vector<float> y(pointCount);
+            x[0] = center.GetPositionX();
+            y[0] = center.GetPositionY();
+            for (uint32 i = 1; i < pointCount; i++)
+            {
+                bool const newPath = i % 20 == 0;
+                x[i] = newPath ? center.GetPositionX() + frand(-300.0f, 300.0f) : x[i - 1] + frand(-3.0f, 3.0f);
+                y[i] = newPath ? center.GetPositionY() + frand(-300.0f, 300.0f) : y[i - 1] + frand(-3.0f, 3.0f);
+            }
+
+            std::vector<float> single(pointCount);
+            uint32 startTime = GetMSTime();
+            for (uint32 i = 0; i < pointCount; i++)
+                single[i] = GetMap()->GetGridMapHeight(x[i], y[i]);
+            uint32 const singleTime = GetMSTimeDiffToNow(startTime);
+
+            std::vector<float> batch(pointCount);
+            startTime = GetMSTime();
+            for (uint32 i = 0; i < pointCount; i += 20)
+                GetMap()->GetGridMapHeights(&x[i], &y[i], &batch[i], 20);
+            uint32 const batchTime = GetMSTimeDiffToNow(startTime);
+
+            for (uint32 i = 0; i < pointCount; i++)
+            {
+                ASSERT_INFO("Height at %f %f: single %f, batch %f", x[i], y[i], single[i], batch[i]);
+                TEST_ASSERT(single[i] == batch[i]);
+            }
+            TC_LOG_INFO("test.unit_test", "Grid heights: %u points, one by one %u ms, batches of 20 %u ms", pointCount, singleTime, batchTime);
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<GridMapHeightBenchmarkImpl>();
+    }
+};
+
+// Replays continent like respawn patterns on the respawn queue and on the fibonacci heap it replaced, both must respawn the same
+class RespawnQueueBenchmark : public TestCaseScript
+{
+public:
+    RespawnQueueBenchmark() : TestCaseScript("maps respawn_queue_benchmark") { }
+
+    class RespawnQueueBenchmarkImpl : public TestCase
+    {
+    public:
+        RespawnQueueBenchmarkImpl() : TestCase(STATUS_PASSING) { }
+
+        static uint32 const SPAWN_COUNT = 300000;
+        static uint32 const SIMULATED_SECONDS = 2 * HOUR;
+
+        // deterministic, so that both runs see the same respawns
+        static uint32 Hash(uint32 spawnId, uint32 n)
+        {
+            uint32 h = spawnId * 2654435761u ^ n * 2246822519u;
+            h ^= h >> 15;
+            h *= 2246822519u;
+            return h ^ (h >> 13);
+        }
+
+        // most spawns are creatures respawning in minutes, then gathering nodes, a few rares and bosses take days
+        static time_t NextRespawn(uint32 spawnId, uint32 n, time_t now)
+        {
+            uint32 const h = Hash(spawnId, n);
+            uint32 const aliveTime = h % 300;
+            switch (spawnId % 20)
+            {
+                case 0: return now + aliveTime + DAY + h % (6 * DAY);
+                case 1: case 2: case 3: case 4: return now + aliveTime + 30 * MINUTE + h % (30 * MINUTE);
+                default: return now + aliveTime + 5 * MINUTE + h % (5 * MINUTE);
+            }
+        }
+
+        // some respawns are blocked (linked respawn, spawn still alive) and checked again a bit later
+        static bool IsDelayed(RespawnInfo const* info, uint32 n) { return Hash(info->spawnId, n + 1000) % 10 == 0; }
+
+        static RespawnInfo* NewRespawn(uint32 spawnId, time_t now)
+        {
+            RespawnInfo* info = new RespawnInfo();
+            info->type = SPAWN_TYPE_CREATURE;
+            info->spawnId = spawnId;
+            info->entry = 0;
+            info->gridId = 0;
+            info->zoneId = 0;
+            info->respawnTime = NextRespawn(spawnId, 0, now) - Hash(spawnId, 1) % (10 * MINUTE); // already dead for a while at start
+            return info;
+        }
+
+        struct CompareRespawnTime
+        {
+            bool operator()(RespawnInfo const* a, RespawnInfo const* b) const
+            {
+                if (a->respawnTime != b->respawnTime)
+                    return a->respawnTime > b->respawnTime;
+                return a->spawnId > b->spawnId;
+            }
+        };
+
+        void Test() override
+        {
+            time_t const start = time(nullptr);
+            std::vector<uint32> respawnCounts(SPAWN_COUNT + 1, 0);
+
+            uint64 heapRespawns = 0;
+            uint32 startTime = GetMSTime();
+            {
+                typedef boost::heap::fibonacci_heap<RespawnInfo*, boost::heap::compare<CompareRespawnTime>> Heap;
+                Heap heap;
+                std::vector<Heap::handle_type> handles(SPAWN_COUNT + 1);
+                for (uint32 spawnId = 1; spawnId <= SPAWN_COUNT; spawnId++)
+                    handles[spawnId] = heap.push(NewRespawn(spawnId, start));
+
+                for (time_t now = start; now < start + SIMULATED_SECONDS; now++)
+                {
+                    while (!heap.empty() && heap.top()->respawnTime <= now)
+                    {
+                        RespawnInfo* info = heap.top();
+                        uint32& n = respawnCounts[info->spawnId];
+                        if (IsDelayed(info, n))
+                        {
+                            info->respawnTime = now + 5 + Hash(info->spawnId, n) % 10;
+                            heap.update(handles[info->spawnId]);
+                            ++n;
+                            continue;
+                        }
+
+                        // respawned, then killed again
+                        heap.pop();
+                        info->respawnTime = NextRespawn(info->spawnId, ++n, now);
+                        handles[info->spawnId] = heap.push(info);
+                        heapRespawns++;
+                    }
+                }
+
+                for (RespawnInfo* info : heap)
+                    delete info;
+            }
+            uint32 const heapTime = GetMSTimeDiffToNow(startTime);
+
+            std::fill(respawnCounts.begin(), respawnCounts.end(), 0);
+            uint64 queueRespawns = 0;
+            startTime = GetMSTime();
+            {
+                RespawnQueue queue(start);
+                std::vector<RespawnInfo*> infos(SPAWN_COUNT + 1, nullptr);
+                for (uint32 spawnId = 1; spawnId <= SPAWN_COUNT; spawnId++)
+                {
+                    infos[spawnId] = NewRespawn(spawnId, start);
+                    queue.Insert(infos[spawnId]);
+                }
+
+                for (time_t now = start; now < start + SIMULATED_SECONDS; now++)
+                {
+                    while (RespawnInfo* info = queue.GetNextDue(now))
+                    {
+                        TEST_ASSERT(info->respawnTime <= now);
+                        uint32& n = respawnCounts[info->spawnId];
+                        if (IsDelayed(info, n))
+                        {
+                            info->respawnTime = now + 5 + Hash(info->spawnId, n) % 10;
+                            queue.Reschedule(info);
+                            ++n;
+                            continue;
+                        }
+
+                        queue.Erase(info);
+                        info->respawnTime = NextRespawn(info->spawnId, ++n, now);
+                        queue.Insert(info);
+                        queueRespawns++;
+                    }
+                }
+
+                TEST_ASSERT(queue.size() == SPAWN_COUNT);
+                queue.Clear();
+                for (RespawnInfo* info : infos)
+                    delete info;
+            }
+            uint32 const queueTime = GetMSTimeDiffToNow(startTime);
+
+            ASSERT_INFO("Fibonacci heap did %u respawns, respawn queue %u", uint32(heapRespawns), uint32(queueRespawns));
+            TEST_ASSERT(heapRespawns == queueRespawns);
+            TC_LOG_INFO("test.unit_test", "Respawns: %u timers over %u s, %u respawns, fibonacci heap %u ms, respawn queue %u ms", SPAWN_COUNT, SIMULATED_SECONDS, uint32(queueRespawns), heapTime, queueTime);
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<RespawnQueueBenchmarkImpl>();
+    }
+};
+
+void AddSC_test_maps()
+{
+    new UnitSpatialIndexTest();
+    new LineOfSightCacheTest();
+    new VMapLineOfSightBenchmark();
+    new VMapLineOfSightMultiTest();
+    new GridMapHeightBenchmark();
+    new RespawnQueueBenchmark();
+}
@@ -0,0 +1,183 @@
+#include "TestCase.h"
+#include "EventProcessor.h"
+#include "Timer.h"
+#include <map>
+
+class EventProcessorTest : public TestCaseScript
+{
+public:
+    EventProcessorTest() : TestCaseScript("utilities event_processor") { }
+
+    class RecordEvent : public BasicEvent
+    {
+    public:
+        RecordEvent(std::vector<uint32>& executed, uint32 id) : _executed(executed), _id(id) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            _executed.push_back(_id);
+            return true;
+        }
+
+    private:
+        std::vector<uint32>& _executed;
+        uint32 _id;
+    };
+
+    // Previous EventProcessor storage, kept for the benchmark. Only handles running events
+    class MultimapEventProcessor
+    {
+    public:
+        ~MultimapEventProcessor()
+        {
+            for (auto const& pair : _events)
+                delete pair.second;
+        }
+
+        void Update(uint32 p_time)
+        {
+            _time += p_time;
+            std::multimap<uint64, BasicEvent*>::iterator itr;
+            while ((itr = _events.begin()) != _events.end() && itr->first <= _time)
+            {
+                BasicEvent* event = itr->second;
+                _events.erase(itr);
+                if (event->Execute(_time, p_time))
+                    delete event;
+            }
+        }
+
+        void AddEvent(BasicEvent* event, uint64 e_time) { _events.insert(std::make_pair(e_time, event)); }
+        uint64 CalculateTime(uint64 offset) const { return _time + offset; }
+
+    private:
+        uint64 _time = 0;
+        std::multimap<uint64, BasicEvent*> _events;
+    };
+
+    class EventProcessorTestImpl : public TestCase
+    {
+    public:
+        EventProcessorTestImpl() : TestCase(STATUS_PASSING) { }
+
+        void Test() override
+        {
+            SECTION("Order", [&] {
+                EventProcessor events;
+                std::vector<uint32> executed;
+                events.AddEvent(new RecordEvent(executed, 3), events.CalculateTime(300));
+                events.AddEvent(new RecordEvent(executed, 1), events.CalculateTime(100));
+                events.AddEvent(new RecordEvent(executed, 2), events.CalculateTime(100)); // same time, must execute after 1
+                events.AddEvent(new RecordEvent(executed, 4), events.CalculateTime(400));
+
+                events.Update(99);
+                TEST_ASSERT(executed.empty());
+                events.Update(250);
+                TEST_ASSERT(executed == std::vector<uint32>({ 1, 2 }));
+                events.Update(1000);
+                TEST_ASSERT(executed == std::vector<uint32>({ 1, 2, 3, 4 }));
+                TEST_ASSERT(events.Empty());
+            });
+
+            SECTION("ModifyEventTime", [&] {
+                EventProcessor events;
+                std::vector<uint32> executed;
+                BasicEvent* moved = new RecordEvent(executed, 1);
+                events.AddEvent(moved, events.CalculateTime(100));
+                events.AddEvent(new RecordEvent(executed, 2), events.CalculateTime(200));
+                events.ModifyEventTime(moved, events.CalculateTime(300));
+
+                events.Update(250);
+                TEST_ASSERT(executed == std::vector<uint32>({ 2 }));
+                events.Update(100);
+                TEST_ASSERT(executed == std::vector<uint32>({ 2, 1 }));
+            });
+
+            SECTION("Abort", [&] {
+                EventProcessor events;
+                std::vector<uint32> executed;
+                BasicEvent* aborted = new RecordEvent(executed, 1);
+                events.AddEvent(aborted, events.CalculateTime(100));
+                events.AddEvent(new RecordEvent(executed, 2), events.CalculateTime(100));
+                aborted->ScheduleAbort();
+
+                events.Update(100);
+                TEST_ASSERT(executed == std::vector<uint32>({ 2 }));
+
+                events.AddEvent(new RecordEvent(executed, 3), events.CalculateTime(100));
+                events.KillAllEvents(false);
+                events.Update(100);
+                TEST_ASSERT(executed == std::vector<uint32>({ 2 }));
+                TEST_ASSERT(events.Empty());
+            });
+
+            // not a strict test, log how long a typical creature load of events takes, against the previous multimap based processor
+            SECTION("Benchmark", [&] {
+                uint32 const processorCount = 10000;
+                uint32 const initialEvents = 15;
+                uint32 const ticks = 40;
+                uint32 const tickTime = 50;
+
+                // same delays for both runs
+                std::vector<uint32> delays((initialEvents + ticks) * processorCount);
+                for (uint32& delay : delays)
+                    delay = urand(0, 2000);
+
+                std::vector<uint32> executed;
+                executed.reserve(delays.size());
+
+                uint32 startTime = GetMSTime();
+                {
+                    std::vector<EventProcessor> processors(processorCount);
+                    uint32 next = 0;
+                    for (EventProcessor& events : processors)
+                        for (uint32 i = 0; i < initialEvents; i++)
+                            events.AddEvent(new RecordEvent(executed, 0), events.CalculateTime(delays[next++]));
+                    for (uint32 tick = 0; tick < ticks; tick++)
+                    {
+                        for (EventProcessor& events : processors)
+                        {
+                            events.AddEvent(new RecordEvent(executed, tick), events.CalculateTime(delays[next++]));
+                            events.Update(tickTime);
+                        }
+                    }
+                }
+                uint32 const heapTime = GetMSTimeDiffToNow(startTime);
+                size_t const heapExecuted = executed.size();
+                executed.clear();
+
+                startTime = GetMSTime();
+                {
+                    std::vector<MultimapEventProcessor> processors(processorCount);
+                    uint32 next = 0;
+                    for (MultimapEventProcessor& events : processors)
+                        for (uint32 i = 0; i < initialEvents; i++)
+                            events.AddEvent(new RecordEvent(executed, 0), events.CalculateTime(delays[next++]));
+                    for (uint32 tick = 0; tick < ticks; tick++)
+                    {
+                        for (MultimapEventProcessor& events : processors)
+                        {
+                            events.AddEvent(new RecordEvent(executed, tick), events.CalculateTime(delays[next++]));
+                            events.Update(tickTime);
+                        }
+                    }
+                }
+                uint32 const multimapTime = GetMSTimeDiffToNow(startTime);
+
+                ASSERT_INFO("Heap executed %u events, multimap %u", uint32(heapExecuted), uint32(executed.size()));
+                TEST_ASSERT(heapExecuted == executed.size());
+                TC_LOG_INFO("test.unit_test", "EventProcessor benchmark: %u processors, %u ticks, %u events executed, heap %u ms, multimap %u ms", processorCount, ticks, uint32(heapExecuted), heapTime, multimapTime);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<EventProcessorTestImpl>();
+    }
+};
+
+void AddSC_test_event_processor()
+{
+    new EventProcessorTest();
+}
@@ -0,0 +1,98 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "ObjectAccessor.h"
+#include "World.h"
+#include "Timer.h"
+#include <thread>
+
+// Models map threads looking up raid members by guid, sharded registry against the previous single lock registry
+class ObjectAccessorLookupBenchmark : public TestCaseScript
+{
+public:
+    ObjectAccessorLookupBenchmark() : TestCaseScript("utilities object_accessor_lookup_benchmark") { }
+
+    class ObjectAccessorLookupBenchmarkImpl : public TestCase
+    {
+    public:
+        ObjectAccessorLookupBenchmarkImpl() : TestCase(STATUS_PASSING, WorldLocation(0, -8833.38f, 628.62f, 94.0f)) { }
+
+        // Run lookup on all threads at once, returns time in ms
+        template<class Lookup>
+        uint32 RunThreads(uint32 threadCount, Lookup const& lookup)
+        {
+            std::vector<std::thread> threads;
+            uint32 const startTime = GetMSTime();
+            for (uint32 i = 0; i < threadCount; i++)
+                threads.emplace_back([&lookup, i]() { lookup(i); });
+            for (std::thread& thread : threads)
+                thread.join();
+            return GetMSTimeDiffToNow(startTime);
+        }
+
+        void Test() override
+        {
+            // a raid, plus as many guids of players not connected (left the group, logged out...)
+            uint32 const raidSize = 25;
+            std::vector<ObjectGuid> guids;
+            std::vector<Player*> expected;
+            for (uint32 i = 0; i < raidSize; i++)
+            {
+                TestPlayer* player = SpawnRandomPlayer();
+                guids.push_back(player->GetGUID());
+                expected.push_back(player);
+                guids.push_back(ObjectGuid(HighGuid::Player, ObjectGuid::LowType(0xFFFFFF00 + i)));
+                expected.push_back(nullptr);
+            }
+            Wait(Seconds(1));
+
+            uint32 const threadCount = std::max<uint32>(sWorld->getIntConfig(CONFIG_NUMTHREADS), 2);
+            uint32 const lookupCount = 500000;
+            std::vector<uint32> mismatches(threadCount, 0);
+
+            uint32 const shardedTime = RunThreads(threadCount, [&](uint32 thread)
+            {
+                for (uint32 i = 0; i < lookupCount; i++)
+                {
+                    uint32 const index = (i * 7 + thread) % guids.size();
+                    if (ObjectAccessor::FindConnectedPlayer(guids[index]) != expected[index])
+                        mismatches[thread]++;
+                }
+            });
+
+            HashMapHolder<Player>::MapType singleLockMap;
+            boost::shared_mutex singleLock;
+            for (uint32 i = 0; i < guids.size(); i++)
+                if (expected[i])
+                    singleLockMap[guids[i]] = expected[i];
+
+            uint32 const singleLockTime = RunThreads(threadCount, [&](uint32 thread)
+            {
+                for (uint32 i = 0; i < lookupCount; i++)
+                {
+                    uint32 const index = (i * 7 + thread) % guids.size();
+                    boost::shared_lock<boost::shared_mutex> lock(singleLock);
+                    auto itr = singleLockMap.find(guids[index]);
+                    if ((itr != singleLockMap.end() ? itr->second : nullptr) != expected[index])
+                        mismatches[thread]++;
+                }
+            });
+
+            for (uint32 thread = 0; thread < threadCount; thread++)
+            {
+                ASSERT_INFO("Thread %u had %u wrong lookups", thread, mismatches[thread]);
+                TEST_ASSERT(mismatches[thread] == 0);
+            }
+            TC_LOG_INFO("test.unit_test", "Player lookups: %u threads x %u lookups, sharded %u ms, single lock %u ms", threadCount, lookupCount, shardedTime, singleLockTime);
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<ObjectAccessorLookupBenchmarkImpl>();
+    }
+};
+
+void AddSC_test_object_accessor()
+{
+    new ObjectAccessorLookupBenchmark();
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2008-2017 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBCCache.h"
+#include "DBCStore.h"
+#include "Log.h"
+#include "SHA1.h"
+#include <boost/filesystem/operations.hpp>
+#include <cstring>
+
+namespace
+{
+    char const DBC_CACHE_MAGIC[4] = { 'D', 'B', 'C', 'I' };
+    uint32 const DBC_CACHE_VERSION = 1;
+
+    /*
+    Image file:
+    - DBCCacheHeader, Digest is the SHA1 of the rest of the file
+    - for each section: uint32 name length, name, uint32 stamp length, stamp, uint64 size,
+      then section data starting at the next 8 bytes boundary
+    */
+    struct DBCCacheHeader
+    {
+        char Magic[4];
+        uint32 Version;
+        uint32 PointerSize;         // sections hold records as laid out in memory
+        uint32 SectionCount;
+        uint8 Digest[SHA_DIGEST_LENGTH];
+    };
+
+    size_t AlignSection(size_t offset)
+    {
+        return (offset + 7) & ~size_t(7);
+    }
+
+    void AppendString(std::vector<char>& file, std::string const& str)
+    {
+        uint32 length = uint32(str.size());
+        file.insert(file.end(), reinterpret_cast<char const*>(&length), reinterpret_cast<char const*>(&length) + sizeof(length));
+        file.insert(file.end(), str.begin(), str.end());
+    }
+}
+
+DBCCache::DBCCache(std::string const& path) : _path(path), _loadedStores(0), _addedStores(0)
+{
+}
+
+bool DBCCache::ReadImage(std::string const& path, std::unique_ptr<char[]>& image, SectionMap& sections)
+{
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    long fileSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (fileSize < long(sizeof(DBCCacheHeader)))
+    {
+        fclose(f);
+        return false;
+    }
+
+    size_t const size = size_t(fileSize);
+    image.reset(new char[size]);
+    bool read = fread(image.get(), size, 1, f) == 1;
+    fclose(f);
+    if (!read)
+        return false;
+
+    DBCCacheHeader header;
+    memcpy(&header, image.get(), sizeof(header));
+    if (memcmp(header.Magic, DBC_CACHE_MAGIC, sizeof(header.Magic)) || header.Version != DBC_CACHE_VERSION || header.PointerSize != sizeof(char*))
+        return false;
+
+    SHA1Hash sha;
+    sha.UpdateData(reinterpret_cast<uint8 const*>(image.get() + sizeof(header)), int(size - sizeof(header)));
+    sha.Finalize();
+    if (memcmp(sha.GetDigest(), header.Digest, SHA_DIGEST_LENGTH))
+        return false;
+
+    size_t offset = sizeof(header);
+    auto readString = [&](std::string& str)
+    {
+        uint32 length;
+        if (offset + sizeof(length) > size)
+            return false;
+
+        memcpy(&length, image.get() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (offset + length > size)
+            return false;
+
+        str.assign(image.get() + offset, length);
+        offset += length;
+        return true;
+    };
+
+    for (uint32 i = 0; i < header.SectionCount; ++i)
+    {
+        std::string name;
+        Section section;
+        if (!readString(name) || !readString(section.Stamp) || offset + sizeof(section.Size) > size)
+            return false;
+
+        memcpy(&section.Size, image.get() + offset, sizeof(section.Size));
+        offset = AlignSection(offset + sizeof(section.Size));
+        if (offset + section.Size > size)
+            return false;
+
+        section.Offset = offset;
+        offset += section.Size;
+        sections[name] = std::move(section);
+    }
+
+    return offset == size;
+}
+
+bool DBCCache::Open()
+{
+    _sections.clear();
+    if (ReadImage(_path, _image, _sections))
+        return true;
+
+    _image.reset();
+    _sections.clear();
+    return false;
+}
+
+bool DBCCache::LoadStore(DBCStorageBase& storage, std::string const& name, std::string const& stamp)
+{
+    SectionMap::iterator itr = _sections.find(name);
+    if (itr == _sections.end() || itr->second.Stamp != stamp || !itr->second.Data.empty())
+        return false;
+
+    itr->second.Used = true;
+    if (!storage.LoadImage(_image.get() + itr->second.Offset, itr->second.Size))
+        return false;
+
+    ++_loadedStores;
+    return true;
+}
+
+void DBCCache::AddStore(DBCStorageBase const& storage, std::string const& name, std::string const& stamp)
+{
+    Section& section = _sections[name];
+    section.Stamp = stamp;
+    section.Offset = 0;
+    storage.WriteImage(section.Data);
+    section.Size = section.Data.size();
+    section.Used = true;
+    ++_addedStores;
+}
+
+bool DBCCache::Save()
+{
+    if (!_addedStores)
+        return true;
+
+    // sections loaded at this startup were changed in memory, take them from the file again
+    std::unique_ptr<char[]> original;
+    SectionMap originalSections;
+    if (_image && !ReadImage(_path, original, originalSections))
+    {
+        original.reset();
+        originalSections.clear();
+    }
+
+    std::vector<char> file(sizeof(DBCCacheHeader));
+    DBCCacheHeader header;
+    memcpy(header.Magic, DBC_CACHE_MAGIC, sizeof(header.Magic));
+    header.Version = DBC_CACHE_VERSION;
+    header.PointerSize = sizeof(char*);
+    header.SectionCount = 0;
+
+    for (SectionMap::value_type const& itr : _sections)
+    {
+        Section const& section = itr.second;
+        if (!section.Used)
+            continue;
+
+        char const* data = section.Data.data();
+        if (section.Data.empty())
+        {
+            SectionMap::const_iterator originalItr = originalSections.find(itr.first);
+            if (originalItr == originalSections.end() || originalItr->second.Stamp != section.Stamp || originalItr->second.Size != section.Size)
+                continue;
+
+            data = original.get() + originalItr->second.Offset;
+        }
+
+        AppendString(file, itr.first);
+        AppendString(file, section.Stamp);
+        file.insert(file.end(), reinterpret_cast<char const*>(&section.Size), reinterpret_cast<char const*>(&section.Size) + sizeof(section.Size));
+        file.resize(AlignSection(file.size()), 0);
+        file.insert(file.end(), data, data + section.Size);
+        ++header.SectionCount;
+    }
+
+    SHA1Hash sha;
+    sha.UpdateData(reinterpret_cast<uint8 const*>(file.data() + sizeof(header)), int(file.size() - sizeof(header)));
+    sha.Finalize();
+    memcpy(header.Digest, sha.GetDigest(), SHA_DIGEST_LENGTH);
+    memcpy(file.data(), &header, sizeof(header));
+
+    // written aside then renamed, other processes may be reading the image
+    std::string tmpPath = _path + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f)
+    {
+        TC_LOG_ERROR("server.loading", "DBCCache: Could not create %s", tmpPath.c_str());
+        return false;
+    }
+
+    bool written = fwrite(file.data(), file.size(), 1, f) == 1;
+    written = fclose(f) == 0 && written;
+
+    boost::system::error_code error;
+    if (written)
+        boost::filesystem::rename(tmpPath, _path, error);
+
+    if (!written || error)
+    {
+        TC_LOG_ERROR("server.loading", "DBCCache: Could not write %s", _path.c_str());
+        boost::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef DBCCache_h__
+#define DBCCache_h__
+
+#include "Define.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class DBCStorageBase;
+
+/*
+Prebuilt binary image of the DBC stores, loaded at startup instead of parsing the dbc files.
+
+The image has one section per store, holding its records as they are laid out in memory. A store loaded from its
+section uses the records in place: only string fields are turned back into pointers, nothing else is parsed or copied.
+Each section is stamped with the files it was built from (size and modification time of the dbc and its locale
+files, and the store format), stores whose files changed are loaded from dbc files again and their section replaced.
+The whole file is checked against a SHA1 digest before being used.
+
+Image memory is owned by the cache, which must thus outlive the stores loaded from it.
+*/
+class TC_SHARED_API DBCCache
+{
+public:
+    explicit DBCCache(std::string const& path);
+
+    // Read the image file, returns false if it does not exist or can't be used (other version, corrupted...)
+    bool Open();
+    // Load store from its section if it was built from the files identified by stamp
+    bool LoadStore(DBCStorageBase& storage, std::string const& name, std::string const& stamp);
+    // Replace section of a store loaded from dbc files, to be called before any change is made to its records
+    void AddStore(DBCStorageBase const& storage, std::string const& name, std::string const& stamp);
+    // Write the image file again if some sections were replaced
+    bool Save();
+
+    uint32 GetLoadedStoreCount() const { return _loadedStores; }
+    uint32 GetAddedStoreCount() const { return _addedStores; }
+
+private:
+    struct Section
+    {
+        Section() : Offset(0), Size(0), Used(false) { }
+
+        std::string Stamp;
+        uint64 Offset;              // in image file, for sections read from it
+        uint64 Size;
+        std::vector<char> Data;     // for sections built at this startup
+        bool Used;                  // sections of stores not loaded anymore are not saved
+    };
+    typedef std::map<std::string, Section> SectionMap;
+
+    static bool ReadImage(std::string const& path, std::unique_ptr<char[]>& image, SectionMap& sections);
+
+    std::string _path;
+    std::unique_ptr<char[]> _image;
+    SectionMap _sections;
+    uint32 _loadedStores;
+    uint32 _addedStores;
+};
+
+#endif // DBCCache_h__
@@ -17,6 +17,54 @@
 
 #include "DBCStore.h"
 #include "DBCDatabaseLoader.h"
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    /*
+    Image of a store, as written by WriteImage:
+    - DBCImageHeader
+    - RecordCount uint32 indexes
+    - RecordCount records, laid out like in memory, string fields hold an offset + 1 in the string block (0 for null strings)
+    - StringsSize bytes of null terminated strings
+    */
+    struct DBCImageHeader
+    {
+        uint32 FieldCount;
+        uint32 IndexTableSize;
+        uint32 RecordSize;
+        uint32 RecordCount;
+        uint32 StringsSize;
+    };
+
+    std::vector<uint32> GetStringFieldOffsets(char const* format)
+    {
+        std::vector<uint32> offsets;
+        uint32 offset = 0;
+        for (uint32 x = 0; format[x]; ++x)
+        {
+            switch (format[x])
+            {
+                case FT_FLOAT:
+                case FT_INT:
+                case FT_IND:
+                    offset += sizeof(uint32);
+                    break;
+                case FT_BYTE:
+                    offset += sizeof(uint8);
+                    break;
+                case FT_STRING:
+                    offsets.push_back(offset);
+                    offset += sizeof(char*);
+                    break;
+                default:
+                    break;
+            }
+        }
+        return offsets;
+    }
+}
 
 DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _dataTableEx(nullptr), _indexTableSize(0)
 {
@@ -74,3 +122,102 @@ void DBCStorageBase::LoadFromDB(std::string const& path, std::string const& dbFo
 {
     _dataTableEx = DBCDatabaseLoader(path, dbFormat, primaryKey, _fileFormat).Load(_indexTableSize, indexTable);
 }
+
+void DBCStorageBase::WriteImage(std::vector<char>& image, char* const* indexTable) const
+{
+    std::vector<uint32> indexes;
+    for (uint32 i = 0; i < _indexTableSize; ++i)
+        if (indexTable[i])
+            indexes.push_back(i);
+
+    DBCImageHeader header;
+    header.FieldCount = _fieldCount;
+    header.IndexTableSize = _indexTableSize;
+    header.RecordSize = DBCFileLoader::GetFormatRecordSize(_fileFormat);
+    header.RecordCount = uint32(indexes.size());
+
+    size_t const recordsOffset = sizeof(header) + indexes.size() * sizeof(uint32);
+    image.assign(recordsOffset + indexes.size() * header.RecordSize, 0);
+
+    // strings shared by several records (mostly empty ones) are stored once
+    std::vector<uint32> const stringFields = GetStringFieldOffsets(_fileFormat);
+    std::unordered_map<std::string_view, uintptr_t> stringOffsets;
+    std::vector<char> strings;
+    for (size_t i = 0; i < indexes.size(); ++i)
+    {
+        char* record = &image[recordsOffset + i * header.RecordSize];
+        memcpy(record, indexTable[indexes[i]], header.RecordSize);
+        for (uint32 fieldOffset : stringFields)
+        {
+            char const* str;
+            memcpy(&str, record + fieldOffset, sizeof(str));
+
+            uintptr_t value = 0;
+            if (str)
+            {
+                auto itr = stringOffsets.emplace(std::string_view(str), strings.size() + 1);
+                if (itr.second)
+                    strings.insert(strings.end(), str, str + strlen(str) + 1);
+                value = itr.first->second;
+            }
+            memcpy(record + fieldOffset, &value, sizeof(value));
+        }
+    }
+
+    header.StringsSize = uint32(strings.size());
+    memcpy(&image[0], &header, sizeof(header));
+    if (!indexes.empty())
+        memcpy(&image[sizeof(header)], indexes.data(), indexes.size() * sizeof(uint32));
+    image.insert(image.end(), strings.begin(), strings.end());
+}
+
+bool DBCStorageBase::LoadImage(char* image, size_t size, char**& indexTable)
+{
+    indexTable = nullptr;
+
+    DBCImageHeader header;
+    if (size < sizeof(header))
+        return false;
+
+    memcpy(&header, image, sizeof(header));
+    size_t const recordsOffset = sizeof(header) + size_t(header.RecordCount) * sizeof(uint32);
+    size_t const stringsOffset = recordsOffset + size_t(header.RecordCount) * header.RecordSize;
+    if (header.RecordSize != DBCFileLoader::GetFormatRecordSize(_fileFormat) || stringsOffset + header.StringsSize != size)
+        return false;
+
+    char* strings = image + stringsOffset;
+    if (header.StringsSize && strings[header.StringsSize - 1] != '\0')
+        return false;
+
+    uint32 const* indexes = reinterpret_cast<uint32 const*>(image + sizeof(header));
+    for (uint32 i = 0; i < header.RecordCount; ++i)
+        if (indexes[i] >= header.IndexTableSize)
+            return false;
+
+    // records are used in place, only string fields need to be turned back to pointers
+    std::vector<uint32> const stringFields = GetStringFieldOffsets(_fileFormat);
+    indexTable = new char*[header.IndexTableSize]();
+    for (uint32 i = 0; i < header.RecordCount; ++i)
+    {
+        char* record = image + recordsOffset + size_t(i) * header.RecordSize;
+        for (uint32 fieldOffset : stringFields)
+        {
+            uintptr_t value;
+            memcpy(&value, record + fieldOffset, sizeof(value));
+            if (value > header.StringsSize)
+            {
+                delete[] indexTable;
+                indexTable = nullptr;
+                return false;
+            }
+
+            char* str = value ? strings + value - 1 : nullptr;
+            memcpy(record + fieldOffset, &str, sizeof(str));
+        }
+        indexTable[indexes[i]] = record;
+    }
+
+    _fieldCount = header.FieldCount;
+    _indexTableSize = header.IndexTableSize;
+    return true;
+}
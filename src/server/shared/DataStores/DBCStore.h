@@ -19,10 +19,16 @@ public:
     virtual bool LoadStringsFrom(std::string const& path) = 0;
     virtual void LoadFromDB(std::string const& path, std::string const& dbFormat, std::string const& primaryKey) = 0;
 
+    // Binary image of the loaded records, see DBCCache. Records are used in place, image must stay allocated as long as the store
+    virtual void WriteImage(std::vector<char>& image) const = 0;
+    virtual bool LoadImage(char* image, size_t size) = 0;
+
 protected:
     bool Load(std::string const& path, char**& indexTable);
     bool LoadStringsFrom(std::string const& path, char** indexTable);
     void LoadFromDB(std::string const& path, std::string const& dbFormat, std::string const& primaryKey, char**& indexTable);
+    void WriteImage(std::vector<char>& image, char* const* indexTable) const;
+    bool LoadImage(char* image, size_t size, char**& indexTable);
 
     uint32 _fieldCount;
     char const* _fileFormat;
@@ -68,6 +74,16 @@ public:
         DBCStorageBase::LoadFromDB(path, dbFormat, primaryKey, _indexTable.AsChar);
     }
 
+    void WriteImage(std::vector<char>& image) const override
+    {
+        DBCStorageBase::WriteImage(image, _indexTable.AsChar);
+    }
+
+    bool LoadImage(char* image, size_t size) override
+    {
+        return DBCStorageBase::LoadImage(image, size, _indexTable.AsChar);
+    }
+
     iterator begin() { return iterator(_indexTable.AsT, _indexTableSize); }
     iterator end() { return iterator(_indexTable.AsT, _indexTableSize, _indexTableSize); }
 
@@ -116,6 +116,13 @@ public:
 		return Trinity::Find(_elements, handle, (SPECIFIC_TYPE*)NULL);
 	}
 
+	/// returns the underlying container for a specific type, or NULL if type is not part of this container
+	template<class SPECIFIC_TYPE>
+	std::unordered_map<KEY_TYPE, SPECIFIC_TYPE*> const* GetContainer() const
+	{
+		return Trinity::GetContainer(_elements, (SPECIFIC_TYPE*)NULL);
+	}
+
 	ContainerUnorderedMap<OBJECT_TYPES, KEY_TYPE>& GetElements() { return _elements; }
 	ContainerUnorderedMap<OBJECT_TYPES, KEY_TYPE> const& GetElements() const { return _elements; }
 
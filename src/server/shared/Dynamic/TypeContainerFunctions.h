@@ -110,6 +110,32 @@ namespace Trinity
 		return ret ? ret : Remove(elements._TailElements, handle, (SPECIFIC_TYPE*)nullptr);
 	}
 
+	// Container access helpers
+	template<class SPECIFIC_TYPE, class KEY_TYPE>
+	std::unordered_map<KEY_TYPE, SPECIFIC_TYPE*> const* GetContainer(ContainerUnorderedMap<SPECIFIC_TYPE, KEY_TYPE> const& elements, SPECIFIC_TYPE* /*obj*/)
+	{
+		return &elements._element;
+	}
+
+	template<class SPECIFIC_TYPE, class KEY_TYPE>
+	std::unordered_map<KEY_TYPE, SPECIFIC_TYPE*> const* GetContainer(ContainerUnorderedMap<TypeNull, KEY_TYPE> const& /*elements*/, SPECIFIC_TYPE* /*obj*/)
+	{
+		return nullptr;
+	}
+
+	template<class SPECIFIC_TYPE, class KEY_TYPE, class T>
+	std::unordered_map<KEY_TYPE, SPECIFIC_TYPE*> const* GetContainer(ContainerUnorderedMap<T, KEY_TYPE> const& /*elements*/, SPECIFIC_TYPE* /*obj*/)
+	{
+		return nullptr;
+	}
+
+	template<class SPECIFIC_TYPE, class KEY_TYPE, class H, class T>
+	std::unordered_map<KEY_TYPE, SPECIFIC_TYPE*> const* GetContainer(ContainerUnorderedMap<TypeList<H, T>, KEY_TYPE> const& elements, SPECIFIC_TYPE* /*obj*/)
+	{
+		std::unordered_map<KEY_TYPE, SPECIFIC_TYPE*> const* ret = GetContainer(elements._elements, (SPECIFIC_TYPE*)nullptr);
+		return ret ? ret : GetContainer(elements._TailElements, (SPECIFIC_TYPE*)nullptr);
+	}
+
 	/* ContainerMapList Helpers */
 	// count functions
 	template<class SPECIFIC_TYPE>
@@ -12,24 +12,90 @@
 
 #include "MMapManager.h"
 
+#include "RecastAlloc.h"
+
+#include <chrono>
+
+// tiles built by the current run, allows resuming an interrupted build with --resume
+#define MMAP_CHECKPOINT_FILE "mmaps/build_checkpoint.txt"
+
 namespace MMAP
 {
+    TileScratch::TileScratch() : solid(rcAllocHeightfield()), liquid(rcAllocHeightfield()) { }
+
+    TileScratch::~TileScratch()
+    {
+        rcFreeHeightField(solid);
+        rcFreeHeightField(liquid);
+    }
+
+    bool TileScratch::resetHeightfield(rcContext* ctx, rcHeightfield& hf, rcConfig const& cfg)
+    {
+        // sub tiles all have the same size, the span grid is only allocated once
+        if (hf.spans && hf.width == cfg.width && hf.height == cfg.height)
+        {
+            memset(hf.spans, 0, sizeof(rcSpan*) * hf.width * hf.height);
+            rcVcopy(hf.bmin, cfg.bmin);
+            rcVcopy(hf.bmax, cfg.bmax);
+            hf.cs = cfg.cs;
+            hf.ch = cfg.ch;
+        }
+        else
+        {
+            rcFree(hf.spans);
+            hf.spans = NULL;
+            if (!rcCreateHeightfield(ctx, hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+                return false;
+        }
+
+        // spans of the previous sub tile go back to the free list, pools are kept
+        hf.freelist = NULL;
+        for (rcSpanPool* pool = hf.pools; pool; pool = pool->next)
+        {
+            for (int i = RC_SPANS_PER_POOL - 1; i >= 0; --i)
+            {
+                pool->items[i].next = hf.freelist;
+                hf.freelist = &pool->items[i];
+            }
+        }
+
+        return true;
+    }
+
+    TileWorker::TileWorker(bool skipLiquid, bool quick) :
+        terrainBuilder(skipLiquid, quick),
+        context(false),
+        navMeshMapId(uint32(-1)),
+        navMesh(NULL)
+    { }
+
+    TileWorker::~TileWorker()
+    {
+        dtFreeNavMesh(navMesh);
+    }
+
     MapBuilder::MapBuilder(bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, int mapid, bool quick, const char* offMeshFilePath) :
+        bool debugOutput, bool bigBaseUnit, int mapid, bool quick, const char* offMeshFilePath,
+        uint32 maxMemoryMB, bool resume) :
         m_terrainBuilder     (NULL),
+        m_skipLiquid         (skipLiquid),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
         m_skipContinents     (skipContinents),
         m_skipJunkMaps       (skipJunkMaps),
         m_skipBattlegrounds  (skipBattlegrounds),
+        m_quick              (quick),
         m_bigBaseUnit        (bigBaseUnit),
         m_mapid              (mapid),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
         m_rcContext          (NULL),
-        _cancelationToken    (false),
-        m_quick(quick)
+        m_maxMemory          (uint64(maxMemoryMB) * 1024 * 1024),
+        _peakMemory          (0u),
+        _tilesInProgress     (0u),
+        m_resume             (resume),
+        _checkpointFile      (NULL)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid, quick);
 
@@ -153,59 +219,266 @@ namespace MMAP
 
     /**************************************************************************/
 
-    void MapBuilder::WorkerThread()
+    void MapBuilder::WorkerThread(uint32 workerIndex)
     {
-        while (1)
-        {
-            uint32 mapId = 0;
+        TileWorker& worker = *_workers[workerIndex];
 
-            _queue.WaitAndPop(mapId);
+        TileWork work;
+        while (true)
+        {
+            waitForMemory();
 
-            if (_cancelationToken)
+            if (!getNextTile(workerIndex, work))
                 return;
 
-            buildMap(mapId);
+            ++_tilesInProgress;
+            buildTile(worker, work.mapId, work.tileX, work.tileY, getWorkerNavMesh(worker, work.mapId));
+            --_tilesInProgress;
+
+            ++m_totalTilesProcessed;
+            saveCheckpoint(work);
+
+            if (--_mapStates.at(work.mapId).remainingTiles == 0)
+                printf("[Map %03i] Complete!\n", work.mapId);
         }
     }
-    void MapBuilder::buildAllMaps(unsigned int threads)
+
+    /**************************************************************************/
+    bool MapBuilder::getNextTile(uint32 workerIndex, TileWork& work)
     {
-        printf("Using %u threads to extract mmaps\n", threads);
+        TileWorker& worker = *_workers[workerIndex];
+        {
+            std::lock_guard<std::mutex> lock(worker.queueLock);
+            if (!worker.queue.empty())
+            {
+                work = worker.queue.front();
+                worker.queue.pop_front();
+                return true;
+            }
+        }
 
-        for (unsigned int i = 0; i < threads; ++i)
+        // out of work, steal half the tiles of the most loaded worker. Tiles are never added once the build started,
+        // so finding all queues empty means we are done
+        while (true)
         {
-            _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
+            TileWorker* victim = NULL;
+            size_t victimSize = 0;
+            for (std::unique_ptr<TileWorker> const& other : _workers)
+            {
+                if (other.get() == &worker)
+                    continue;
+
+                std::lock_guard<std::mutex> lock(other->queueLock);
+                if (other->queue.size() > victimSize)
+                {
+                    victim = other.get();
+                    victimSize = other->queue.size();
+                }
+            }
+
+            if (!victim)
+                return false;
+
+            std::vector<TileWork> stolen;
+            {
+                std::lock_guard<std::mutex> lock(victim->queueLock);
+                // taken from the back, victim keeps working on the tiles next to its current one
+                size_t count = (victim->queue.size() + 1) / 2;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    stolen.push_back(victim->queue.back());
+                    victim->queue.pop_back();
+                }
+            }
+
+            // queue was emptied meanwhile, look again
+            if (stolen.empty())
+                continue;
+
+            work = stolen.back();
+            stolen.pop_back();
+
+            std::lock_guard<std::mutex> lock(worker.queueLock);
+            for (std::vector<TileWork>::reverse_iterator itr = stolen.rbegin(); itr != stolen.rend(); ++itr)
+                worker.queue.push_back(*itr);
+            return true;
         }
+    }
 
-        m_tiles.sort([](MapTiles a, MapTiles b)
+    /**************************************************************************/
+    dtNavMesh* MapBuilder::getWorkerNavMesh(TileWorker& worker, uint32 mapID)
+    {
+        // navmesh is only used to validate tiles before writing them, each worker has its own as they are not thread safe
+        if (worker.navMeshMapId == mapID)
+            return worker.navMesh;
+
+        dtFreeNavMesh(worker.navMesh);
+        worker.navMesh = dtAllocNavMesh();
+        worker.navMeshMapId = mapID;
+        if (!worker.navMesh->init(&_mapStates.at(mapID).navMeshParams))
+            printf("[Map %03i] Failed creating navmesh!\n", mapID);
+
+        return worker.navMesh;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::waitForMemory()
+    {
+        uint64 memory = getResidentMemory();
+        uint64 peakMemory = _peakMemory;
+        while (memory > peakMemory && !_peakMemory.compare_exchange_weak(peakMemory, memory))
+            ;
+
+        // always let one tile run, else nothing would free memory
+        while (m_maxMemory && memory > m_maxMemory && _tilesInProgress > 0)
         {
-            return a.m_tiles->size() > b.m_tiles->size();
-        });
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            memory = getResidentMemory();
+        }
+    }
 
-        for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+    /**************************************************************************/
+    void MapBuilder::loadCheckpoint(std::set<std::tuple<uint32, uint32, uint32>>& doneTiles)
+    {
+        FILE* file = fopen(MMAP_CHECKPOINT_FILE, "r");
+        if (!file)
+            return;
+
+        uint32 mapId, tileX, tileY;
+        while (fscanf(file, "%u %u %u", &mapId, &tileX, &tileY) == 3)
+            doneTiles.insert(std::make_tuple(mapId, tileX, tileY));
+
+        fclose(file);
+        printf("Resuming build, %u tiles already done\n", uint32(doneTiles.size()));
+    }
+
+    void MapBuilder::saveCheckpoint(TileWork const& work)
+    {
+        if (!_checkpointFile)
+            return;
+
+        std::lock_guard<std::mutex> lock(_checkpointLock);
+        fprintf(_checkpointFile, "%u %u %u\n", work.mapId, work.tileX, work.tileY);
+        fflush(_checkpointFile);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::prepareMap(uint32 mapID, std::vector<TileWork>& work)
+    {
+        std::set<uint32>* tiles = getTileList(mapID);
+        if (tiles->empty())
+            return;
+
+        dtNavMesh* navMesh = NULL;
+        buildNavMesh(mapID, navMesh);
+        if (!navMesh)
         {
-            uint32 mapId = it->m_mapId;
-            if (!shouldSkipMap(mapId))
+            printf("[Map %03i] Failed creating navmesh!\n", mapID);
+            m_totalTilesProcessed += tiles->size();
+            return;
+        }
+
+        MapBuildState& state = _mapStates[mapID];
+        state.navMeshParams = *navMesh->getParams();
+        state.remainingTiles = 0;
+        dtFreeNavMesh(navMesh);
+
+        printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
+        for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+        {
+            uint32 tileX, tileY;
+
+            // unpack tile coords
+            StaticMapTree::unpackTileID((*it), tileX, tileY);
+
+            if (shouldSkipTile(mapID, tileX, tileY))
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                ++m_totalTilesProcessed;
+                continue;
             }
+
+            work.push_back({ mapID, tileX, tileY });
+            ++state.remainingTiles;
         }
+    }
 
-        while (!_queue.Empty())
+    /**************************************************************************/
+    void MapBuilder::buildTiles(std::vector<TileWork>& work, unsigned int threads)
+    {
+        if (m_resume)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            std::set<std::tuple<uint32, uint32, uint32>> doneTiles;
+            loadCheckpoint(doneTiles);
+            work.erase(std::remove_if(work.begin(), work.end(), [&](TileWork const& tile)
+            {
+                if (!doneTiles.count(std::make_tuple(tile.mapId, tile.tileX, tile.tileY)))
+                    return false;
+
+                ++m_totalTilesProcessed;
+                --_mapStates[tile.mapId].remainingTiles;
+                return true;
+            }), work.end());
         }
 
-        _cancelationToken = true;
+        _checkpointFile = fopen(MMAP_CHECKPOINT_FILE, m_resume ? "a" : "w");
+        if (!_checkpointFile)
+            printf("Failed to open %s, build will not be resumable\n", MMAP_CHECKPOINT_FILE);
+
+        if (m_maxMemory && !getResidentMemory())
+            printf("Memory usage is unknown on this platform, --maxMemory is ignored\n");
 
-        _queue.Cancel();
+        // give each worker a contiguous range of tiles, neighbour tiles share most of their vmap models
+        uint32 workerCount = std::max(threads, 1u);
+        for (uint32 i = 0; i < workerCount; ++i)
+            _workers.emplace_back(new TileWorker(m_skipLiquid, m_quick));
 
-        for (auto& thread : _workerThreads)
+        for (size_t i = 0; i < work.size(); ++i)
+            _workers[i * workerCount / work.size()]->queue.push_back(work[i]);
+
+        if (threads > 0)
+        {
+            std::vector<std::thread> workerThreads;
+            for (uint32 i = 0; i < workerCount; ++i)
+                workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this, i));
+
+            for (auto& thread : workerThreads)
+                thread.join();
+        }
+        else
+            WorkerThread(0);
+
+        _workers.clear();
+
+        // whole build done, nothing to resume anymore
+        if (_checkpointFile)
         {
-            thread.join();
+            fclose(_checkpointFile);
+            _checkpointFile = NULL;
+            remove(MMAP_CHECKPOINT_FILE);
         }
+
+        if (_peakMemory)
+            printf("Peak memory usage: %u MB\n", uint32(_peakMemory / (1024 * 1024)));
+    }
+
+    void MapBuilder::buildAllMaps(unsigned int threads)
+    {
+        printf("Using %u threads to extract mmaps\n", threads);
+
+        m_tiles.sort([](MapTiles a, MapTiles b)
+        {
+            return a.m_tiles->size() > b.m_tiles->size();
+        });
+
+        std::vector<TileWork> work;
+        for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+        {
+            uint32 mapId = it->m_mapId;
+            if (!shouldSkipMap(mapId))
+                prepareMap(mapId, work);
+        }
+
+        buildTiles(work, threads);
     }
     /**************************************************************************/
     void MapBuilder::getGridBounds(uint32 mapID, uint32 &minX, uint32 &minY, uint32 &maxX, uint32 &maxY) const
@@ -333,7 +606,8 @@ namespace MMAP
         getTileBounds(tileX, tileY, data.solidVerts.getCArray(), data.solidVerts.size() / 3, bmin, bmax);
 
         // build navmesh tile
-        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh);
+        TileWorker worker(m_skipLiquid, m_quick);
+        buildMoveMapTile(worker, mapId, tileX, tileY, data, bmin, bmax, navMesh);
         fclose(file);
     }
 
@@ -348,51 +622,21 @@ namespace MMAP
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh);
+        TileWorker worker(m_skipLiquid, m_quick);
+        buildTile(worker, mapID, tileX, tileY, navMesh);
         dtFreeNavMesh(navMesh);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, unsigned int threads)
     {
-        std::set<uint32>* tiles = getTileList(mapID);
-
-        if (!tiles->empty())
-        {
-            // build navMesh
-            dtNavMesh* navMesh = NULL;
-            buildNavMesh(mapID, navMesh);
-            if (!navMesh)
-            {
-                printf("[Map %03i] Failed creating navmesh!\n", mapID);
-                m_totalTilesProcessed += tiles->size();
-                return;
-            }
-
-            // now start building mmtiles for each tile
-            printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
-            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
-            {
-                uint32 tileX, tileY;
-
-                // unpack tile coords
-                StaticMapTree::unpackTileID((*it), tileX, tileY);
-
-                if (!shouldSkipTile(mapID, tileX, tileY))
-                    buildTile(mapID, tileX, tileY, navMesh);
-
-                ++m_totalTilesProcessed;
-                
-            }
-
-            dtFreeNavMesh(navMesh);
-        }
-
-        printf("[Map %03i] Complete!\n", mapID);
+        std::vector<TileWork> work;
+        prepareMap(mapID, work);
+        buildTiles(work, threads);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    void MapBuilder::buildTile(TileWorker& worker, uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
         printf("%u%% [Map %03i] Building tile [%02u,%02u]\n", percentageDone(m_totalTiles, m_totalTilesProcessed), mapID, tileX, tileY);
         printf("[Map %03i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
@@ -400,14 +644,14 @@ namespace MMAP
         MeshData meshData;
 
         // get heightmap data
-        m_terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
+        worker.terrainBuilder.loadMap(mapID, tileX, tileY, meshData);
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
         TerrainBuilder::cleanVertices(meshData.liquidVerts, meshData.liquidTris);
 
         // get model data
-        m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
+        worker.terrainBuilder.loadVMap(mapID, tileY, tileX, meshData);
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
@@ -429,11 +673,11 @@ namespace MMAP
         float bmin[3], bmax[3];
         getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        worker.terrainBuilder.loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
-        m_terrainBuilder->unloadVMap(mapID, tileY, tileX);
+        buildMoveMapTile(worker, mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        worker.terrainBuilder.unloadVMap(mapID, tileY, tileX);
     }
 
     /**************************************************************************/
@@ -521,7 +765,7 @@ namespace MMAP
     }
 
     //mark triangle under terrain as non walkable (adapted from nost)
-    void MapBuilder::removeVMAPTrianglesUnderTerrain(uint32 MapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount)
+    void MapBuilder::removeVMAPTrianglesUnderTerrain(TerrainBuilder& terrainBuilder, uint32 MapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount)
     {
         /* sun; removed for now, does not seem working + don't see obvious cases where this is useful for now
         float norm[3];
@@ -543,13 +787,13 @@ namespace MMAP
                         verts[3 * c + v] = (5 * tVerts[tTris[c] * 3 + v] + tVerts[tTris[(c + 1) % 3] * 3 + v] + tVerts[tTris[(c + 2) % 3] * 3 + v]) / 7;
 
                 // A triangle is undermap if all corners are undermap
-                bool undermap1 = m_terrainBuilder->IsUnderMap(MapID, &verts[0]);
+                bool undermap1 = terrainBuilder.IsUnderMap(MapID, &verts[0]);
                 if (!undermap1)
                     continue;
-                bool undermap2 = m_terrainBuilder->IsUnderMap(MapID, &verts[3]);
+                bool undermap2 = terrainBuilder.IsUnderMap(MapID, &verts[3]);
                 if (!undermap2)
                     continue;
-                bool undermap3 = m_terrainBuilder->IsUnderMap(MapID, &verts[6]);
+                bool undermap3 = terrainBuilder.IsUnderMap(MapID, &verts[6]);
                 if (!undermap3)
                     continue;
 
@@ -614,7 +858,7 @@ namespace MMAP
 
 
     /**************************************************************************/
-    void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    void MapBuilder::buildMoveMapTile(TileWorker& worker, uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
@@ -687,13 +931,29 @@ namespace MMAP
         rcPolyMesh** pmmerge = new rcPolyMesh*[TILES_PER_MAP * TILES_PER_MAP];
         rcPolyMeshDetail** dmmerge = new rcPolyMeshDetail*[TILES_PER_MAP * TILES_PER_MAP];
         int nmerge = 0;
+
+        /// Mark all triangles with correct flags:
+        // Can't use rcMarkWalkableTriangles. We need something really more specific.
+        // mark all walkable tiles, both liquids and solids
+        // flags only depend on the triangles, they are computed once for all sub tiles
+        std::vector<unsigned char>& triFlags = worker.scratch.triFlags;
+        triFlags.assign(tTriCount, NAV_EMPTY); //start empty instead of NAV_GROUND
+        //rcClearUnwalkableTriangles(m_rcContext, tileCfg.walkableSlopeAngle, tVerts, tVertCount, tTris, tTriCount, triFlags);
+        markWalkableTriangles(meshData, triFlags.data(), tVerts, tTris, tTriCount); // sun addition, replaces rcClearUnwalkableTriangles (adapted from nost)
+        // Now we remove terrain triangles under the mesh (actually set flags to 0), using the map and vmap tiles loaded by this worker
+        if(!m_quick)
+            removeVMAPTrianglesUnderTerrain(worker.terrainBuilder, mapID, meshData, triFlags.data(), tVerts, tTris, tTriCount);
+
+        rcContext* ctx = &worker.context;
+        rcHeightfield& solid = *worker.scratch.solid;
+        rcHeightfield& liquids = *worker.scratch.liquid;
+
         // build all tiles
         for (int y = 0; y < TILES_PER_MAP; ++y)
         {
             for (int x = 0; x < TILES_PER_MAP; ++x)
             {
                 Tile& tile = tiles[x + y * TILES_PER_MAP];
-                Tile liquidsTile;
 
                 // Calculate the per tile bounding box.
                 tileCfg.bmin[0] = config.bmin[0] + float(x*config.tileSize - config.borderSize)*config.cs;
@@ -702,9 +962,8 @@ namespace MMAP
                 tileCfg.bmax[2] = config.bmin[2] + float((y+1)*config.tileSize + config.borderSize)*config.cs;
 
                 // build heightfield
-                /// 1. Alloc heightfield for walkable areas
-                tile.solid = rcAllocHeightfield();
-                if (!tile.solid || !rcCreateHeightfield(m_rcContext, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
+                /// 1. Reset heightfield for walkable areas
+                if (!TileScratch::resetHeightfield(ctx, solid, tileCfg))
                 {
                     printf("%s Failed building heightfield!            \n", tileString);
                     continue;
@@ -712,67 +971,55 @@ namespace MMAP
 
                 /// 2. Generate heightfield for water. Put all liquid geometry there
                 // We need to build liquid heighfield to set poly swim flag under.
-                liquidsTile.solid = rcAllocHeightfield();
-                if (!liquidsTile.solid || !rcCreateHeightfield(m_rcContext, *liquidsTile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
+                if (!TileScratch::resetHeightfield(ctx, liquids, tileCfg))
                 {
                     printf("%sFailed building liquids heightfield!            \n", tileString);
                     continue;
                 }
-                rcRasterizeTriangles(m_rcContext, lVerts, lVertCount, lTris, lTriFlags, lTriCount, *liquidsTile.solid, 0);
-
-                /// 3. Mark all triangles with correct flags:
-                // Can't use rcMarkWalkableTriangles. We need something really more specific.
-                // mark all walkable tiles, both liquids and solids
-                unsigned char* triFlags = new unsigned char[tTriCount];
-                memset(triFlags, NAV_EMPTY, tTriCount*sizeof(unsigned char)); //start empty instead of NAV_GROUND
-                //rcClearUnwalkableTriangles(m_rcContext, tileCfg.walkableSlopeAngle, tVerts, tVertCount, tTris, tTriCount, triFlags);
-                markWalkableTriangles(meshData, triFlags, tVerts, tTris, tTriCount); // sun addition, replaces rcClearUnwalkableTriangles (adapted from nost)
-                // Now we remove terrain triangles under the mesh (actually set flags to 0)
-                if(!m_quick)
-                    removeVMAPTrianglesUnderTerrain(mapID, meshData, triFlags, tVerts, tTris, tTriCount);
-
-                rcRasterizeTriangles(m_rcContext, tVerts, tVertCount, tTris, triFlags, tTriCount, *tile.solid, config.walkableClimb);
-                delete[] triFlags;
-
-                rcFilterLowHangingWalkableObstacles(m_rcContext, config.walkableClimb, *tile.solid);
-                rcFilterLedgeSpans(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid);
-                rcFilterWalkableLowHeightSpans(m_rcContext, tileCfg.walkableHeight, *tile.solid);
+                rcRasterizeTriangles(ctx, lVerts, lVertCount, lTris, lTriFlags, lTriCount, liquids, 0);
+
+                /// 3. Rasterize walkable triangles
+                rcRasterizeTriangles(ctx, tVerts, tVertCount, tTris, triFlags.data(), tTriCount, solid, config.walkableClimb);
+
+                rcFilterLowHangingWalkableObstacles(ctx, config.walkableClimb, solid);
+                rcFilterLedgeSpans(ctx, tileCfg.walkableHeight, tileCfg.walkableClimb, solid);
+                rcFilterWalkableLowHeightSpans(ctx, tileCfg.walkableHeight, solid);
                 
                 // sun addition (adapted from nost)
                 // When water is not deep, we have a transition area (AREA_WATER_TRANSITION)
                 // Both ground and water creatures can be there.
                 // Otherwise, the terrain in deeper waters is considered as actual swim/water terrain.
-                filterWalkableLowHeightSpansWith(*liquidsTile.solid, *tile.solid, inWaterGround, stepForGroundInheriteWater);
+                filterWalkableLowHeightSpansWith(liquids, solid, inWaterGround, stepForGroundInheriteWater);
 
                 // compact heightfield spans
                 tile.chf = rcAllocCompactHeightfield();
-                if (!tile.chf || !rcBuildCompactHeightfield(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
+                if (!tile.chf || !rcBuildCompactHeightfield(ctx, tileCfg.walkableHeight, tileCfg.walkableClimb, solid, *tile.chf))
                 {
                     printf("%s Failed compacting heightfield!            \n", tileString);
                     continue;
                 }
 
                 // build polymesh intermediates
-                if (!rcErodeWalkableArea(m_rcContext, config.walkableRadius, *tile.chf))
+                if (!rcErodeWalkableArea(ctx, config.walkableRadius, *tile.chf))
                 {
                     printf("%s Failed eroding area!                    \n", tileString);
                     continue;
                 }
 
-                if (!rcBuildDistanceField(m_rcContext, *tile.chf))
+                if (!rcBuildDistanceField(ctx, *tile.chf))
                 {
                     printf("%s Failed building distance field!         \n", tileString);
                     continue;
                 }
 
-                if (!rcBuildRegions(m_rcContext, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
+                if (!rcBuildRegions(ctx, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
                 {
                     printf("%s Failed building regions!                \n", tileString);
                     continue;
                 }
 
                 tile.cset = rcAllocContourSet();
-                if (!tile.cset || !rcBuildContours(m_rcContext, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
+                if (!tile.cset || !rcBuildContours(ctx, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
                 {
                     printf("%s Failed building contours!               \n", tileString);
                     continue;
@@ -780,14 +1027,14 @@ namespace MMAP
 
                 // build polymesh
                 tile.pmesh = rcAllocPolyMesh();
-                if (!tile.pmesh || !rcBuildPolyMesh(m_rcContext, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
+                if (!tile.pmesh || !rcBuildPolyMesh(ctx, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
                 {
                     printf("%s Failed building polymesh!               \n", tileString);
                     continue;
                 }
 
                 tile.dmesh = rcAllocPolyMeshDetail();
-                if (!tile.dmesh || !rcBuildPolyMeshDetail(m_rcContext, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg.detailSampleMaxError, *tile.dmesh))
+                if (!tile.dmesh || !rcBuildPolyMeshDetail(ctx, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg.detailSampleMaxError, *tile.dmesh))
                 {
                     printf("%s Failed building polymesh detail!        \n", tileString);
                     continue;
@@ -796,8 +1043,6 @@ namespace MMAP
                 // free those up
                 // we may want to keep them in the future for debug
                 // but right now, we don't have the code to merge them
-                rcFreeHeightField(tile.solid);
-                tile.solid = NULL;
                 rcFreeCompactHeightfield(tile.chf);
                 tile.chf = NULL;
                 rcFreeContourSet(tile.cset);
@@ -818,7 +1063,7 @@ namespace MMAP
             delete[] tiles;
             return;
         }
-        rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
+        rcMergePolyMeshes(ctx, pmmerge, nmerge, *iv.polyMesh);
 
         iv.polyMeshDetail = rcAllocPolyMeshDetail();
         if (!iv.polyMeshDetail)
@@ -829,7 +1074,7 @@ namespace MMAP
             delete[] tiles;
             return;
         }
-        rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
+        rcMergePolyMeshDetails(ctx, dmmerge, nmerge, *iv.polyMeshDetail);
 
         // free things up
         delete[] pmmerge;
@@ -938,13 +1183,16 @@ namespace MMAP
             }
 
             // file output
+            // written under a temporary name, an interrupted build must not leave a truncated tile that shouldSkipTile would accept
             char fileName[255];
             sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
-            FILE* file = fopen(fileName, "wb");
+            char tempFileName[260];
+            sprintf(tempFileName, "%s.tmp", fileName);
+            FILE* file = fopen(tempFileName, "wb");
             if (!file)
             {
                 char message[1024];
-                sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, fileName);
+                sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, tempFileName);
                 perror(message);
                 navMesh->removeTile(tileRef, NULL, NULL);
                 break;
@@ -954,7 +1202,7 @@ namespace MMAP
 
             // write header
             MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids();
+            header.usesLiquids = worker.terrainBuilder.usesLiquids();
             header.size = uint32(navDataSize);
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
@@ -962,6 +1210,14 @@ namespace MMAP
             fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
 
+            remove(fileName);
+            if (rename(tempFileName, fileName) != 0)
+            {
+                char message[1024];
+                sprintf(message, "[Map %03i] Failed to rename %s!\n", mapID, tempFileName);
+                perror(message);
+            }
+
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, NULL, NULL);
         }
@@ -24,14 +24,17 @@
 #include <set>
 #include <map>
 #include <list>
+#include <deque>
+#include <mutex>
+#include <memory>
 #include <atomic>
+#include <tuple>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
 
 #include "Recast.h"
 #include "DetourNavMesh.h"
-#include "ProducerConsumerQueue.h"
 
 using namespace VMAP;
 
@@ -73,6 +76,53 @@ namespace MMAP
         rcPolyMeshDetail* dmesh;
     };
 
+    // one mmtile to build. Tiles of all maps are scheduled together, so that a continent is spread over all threads
+    struct TileWork
+    {
+        uint32 mapId;
+        uint32 tileX;
+        uint32 tileY;
+    };
+
+    // Recast data reused for every sub tile built by a thread, instead of being allocated again for each of them
+    struct TileScratch
+    {
+        TileScratch();
+        ~TileScratch();
+
+        // prepare heightfield for a new sub tile, keeping its span pools
+        static bool resetHeightfield(rcContext* ctx, rcHeightfield& hf, rcConfig const& cfg);
+
+        rcHeightfield* solid;
+        rcHeightfield* liquid;
+        std::vector<unsigned char> triFlags;
+    };
+
+    // everything a build thread uses, threads share nothing but the tile queues
+    struct TileWorker
+    {
+        TileWorker(bool skipLiquid, bool quick);
+        ~TileWorker();
+
+        TerrainBuilder terrainBuilder;
+        rcContext context;
+        TileScratch scratch;
+
+        // navmesh of the last map this worker built a tile for
+        uint32 navMeshMapId;
+        dtNavMesh* navMesh;
+
+        // tiles left to this worker. Owner takes from the front, other workers steal from the back
+        std::mutex queueLock;
+        std::deque<TileWork> queue;
+    };
+
+    struct MapBuildState
+    {
+        dtNavMeshParams navMeshParams;
+        std::atomic<uint32> remainingTiles;
+    };
+
     class MapBuilder
     {
         public:
@@ -85,12 +135,14 @@ namespace MMAP
                 bool bigBaseUnit         = false,
                 int mapid                = -1,
                 bool quick               = false,
-                const char* offMeshFilePath = NULL);
+                const char* offMeshFilePath = NULL,
+                uint32 maxMemoryMB       = 0,
+                bool resume              = false);
 
             ~MapBuilder();
 
             // builds all mmap tiles for the specified map id (ignores skip settings)
-            void buildMap(uint32 mapID);
+            void buildMap(uint32 mapID, unsigned int threads);
             void buildMeshFromFile(char* name);
 
             // builds an mmap tile for the specified map and its mesh
@@ -99,22 +151,37 @@ namespace MMAP
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
             void buildAllMaps(unsigned int threads);
 
-            void WorkerThread();
+            void WorkerThread(uint32 workerIndex);
 
         private:
+            // build navmesh params of the map and queue its tiles
+            void prepareMap(uint32 mapID, std::vector<TileWork>& work);
+            // build given tiles using all threads (on this one if threads is 0)
+            void buildTiles(std::vector<TileWork>& work, unsigned int threads);
+            bool getNextTile(uint32 workerIndex, TileWork& work);
+            dtNavMesh* getWorkerNavMesh(TileWorker& worker, uint32 mapID);
+
+            // don't start new tiles while the process uses more than m_maxMemory, unless no other tile is being built
+            void waitForMemory();
+
+            // list of tiles already built by an interrupted run
+            void loadCheckpoint(std::set<std::tuple<uint32, uint32, uint32>>& doneTiles);
+            void saveCheckpoint(TileWork const& work);
+
             // detect maps and tiles
             void discoverTiles();
             std::set<uint32>* getTileList(uint32 mapID);
 
             void markWalkableTriangles(MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount);
-            void removeVMAPTrianglesUnderTerrain(uint32 mapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount);
+            void removeVMAPTrianglesUnderTerrain(TerrainBuilder& terrainBuilder, uint32 mapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount);
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            void buildTile(TileWorker& worker, uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
             // move map building
-            void buildMoveMapTile(uint32 mapID,
+            void buildMoveMapTile(TileWorker& worker,
+                uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData &meshData,
@@ -136,6 +203,8 @@ namespace MMAP
             TerrainBuilder* m_terrainBuilder;
             TileList m_tiles;
 
+            bool m_skipLiquid;
+
             bool m_debugOutput;
 
             const char* m_offMeshFilePath;
@@ -161,9 +230,16 @@ namespace MMAP
             // build performance - not really used for now
             rcContext* m_rcContext;
 
-            std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
-            std::atomic<bool> _cancelationToken;
+            std::vector<std::unique_ptr<TileWorker>> _workers;
+            std::map<uint32, MapBuildState> _mapStates;
+
+            uint64 m_maxMemory;
+            std::atomic<uint64> _peakMemory;
+            std::atomic<uint32> _tilesInProgress;
+
+            bool m_resume;
+            std::mutex _checkpointLock;
+            FILE* _checkpointFile;
     };
 }
 #endif
\ No newline at end of file
@@ -27,6 +27,9 @@
 #ifndef _WIN32
     #include <stddef.h>
     #include <dirent.h>
+    #include <unistd.h>
+#else
+    #include <psapi.h>
 #endif
 
 #ifdef __linux__
@@ -120,6 +123,31 @@ namespace MMAP
 
         return LISTFILE_OK;
     }
+
+    // resident memory of the process in bytes, 0 if unknown on this platform
+    inline uint64 getResidentMemory()
+    {
+    #ifdef WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.WorkingSetSize;
+        return 0;
+    #elif defined(__linux__)
+        FILE* file = fopen("/proc/self/statm", "r");
+        if (!file)
+            return 0;
+
+        unsigned long long size = 0, resident = 0;
+        int count = fscanf(file, "%llu %llu", &size, &resident);
+        fclose(file);
+        if (count != 2)
+            return 0;
+
+        return uint64(resident) * uint64(sysconf(_SC_PAGESIZE));
+    #else
+        return 0;
+    #endif
+    }
 }
 
 #endif
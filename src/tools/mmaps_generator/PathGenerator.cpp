@@ -59,7 +59,9 @@ bool handleArgs(int argc, char** argv,
                char* &offMeshInputPath,
                char* &file,
                unsigned int& threads,
-               bool& quick)
+               bool& quick,
+               unsigned int& maxMemory,
+               bool& resume)
 {
     char* param = NULL;
     for (int i = 1; i < argc; ++i)
@@ -194,6 +196,17 @@ bool handleArgs(int argc, char** argv,
         {
             quick = true;
         }
+        else if (strcmp(argv[i], "--maxMemory") == 0)
+        {
+            param = argv[++i];
+            if (!param)
+                return false;
+            maxMemory = static_cast<unsigned int>(std::max(0, atoi(param)));
+        }
+        else if (strcmp(argv[i], "--resume") == 0)
+        {
+            resume = true;
+        }
         else
         {
             int map = atoi(argv[i]);
@@ -231,13 +244,15 @@ int main(int argc, char** argv)
          debugOutput = false,
          silent = false,
          bigBaseUnit = false,
-         quick = false;
+         quick = false,
+         resume = false;
+    unsigned int maxMemory = 0; // MB, 0 for no limit
     char* offMeshInputPath = NULL;
     char* file = NULL;
 
     bool validParam = handleArgs(argc, argv, mapnum,
                                  tileX, tileY, skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds,
-                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads, quick);
+                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads, quick, maxMemory, resume);
 
     if (!validParam)
         return silent ? -1 : finish("You have specified invalid parameters", -1);
@@ -258,7 +273,7 @@ int main(int argc, char** argv)
         return silent ? -3 : finish("Press ENTER to close...", -3);
 
     MapBuilder builder(skipLiquid, skipContinents, skipJunkMaps,
-                       skipBattlegrounds, debugOutput, bigBaseUnit, mapnum, quick, offMeshInputPath);
+                       skipBattlegrounds, debugOutput, bigBaseUnit, mapnum, quick, offMeshInputPath, maxMemory, resume);
 
     uint32 start = GetMSTime();
     if (file)
@@ -266,7 +281,7 @@ int main(int argc, char** argv)
     else if (tileX > -1 && tileY > -1 && mapnum >= 0)
         builder.buildSingleTile(mapnum, tileX, tileY);
     else if (mapnum >= 0)
-        builder.buildMap(uint32(mapnum));
+        builder.buildMap(uint32(mapnum), threads);
     else
         builder.buildAllMaps(threads);
 
@@ -16,8 +16,12 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <string>
 #include <iostream>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #include "TileAssembler.h"
 #include "Banner.h"
@@ -28,23 +32,34 @@ int main(int argc, char* argv[])
 
     std::string src = "Buildings";
     std::string dest = "vmaps";
+    unsigned int threads = std::thread::hardware_concurrency();
 
-    if (argc > 3)
+    std::vector<std::string> positionalArgs;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = static_cast<unsigned int>(std::max(1, atoi(argv[++i])));
+        else
+            positionalArgs.push_back(argv[i]);
+    }
+
+    if (positionalArgs.size() > 2)
+    {
+        std::cout << "usage: " << argv[0] << " [--threads <count>] <raw data dir> <vmap dest dir>" << std::endl;
         return 1;
     }
     else
     {
-        if (argc > 1)
-            src = argv[1];
-        if (argc > 2)
-            dest = argv[2];
+        if (positionalArgs.size() > 0)
+            src = positionalArgs[0];
+        if (positionalArgs.size() > 1)
+            dest = positionalArgs[1];
     }
 
-    std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
+    std::cout << "using " << src << " as source directory and writing output to " << dest << " with " << threads << " threads" << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    ta->setThreadCount(threads);
 
     if (!ta->convertWorld2())
     {